@@ -0,0 +1,19 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-15
+ * @brief Schedules threads to be run on the CPU
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#ifdef __arch_x86_64
+#include <kernel/arch/x86_64/scheduler.h>
+#else
+#error "Unsupported architecture"
+#endif
\ No newline at end of file
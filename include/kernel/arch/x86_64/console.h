@@ -0,0 +1,76 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-14
+ * @brief Maps file descriptors to persistent console devices
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+#include <span>
+
+#include <kernel/arch/x86_64/uart.h>
+
+namespace Console {
+	/**
+	 * @brief The number of file descriptors that can be mapped to a console device
+	 *
+	 */
+	constexpr int MAX_FDS = 3;
+
+	/**
+	 * @brief Switch the console devices to interrupt driven output
+	 *
+	 * @note Must be called after SoftIRQ::init(), before this the devices are polled
+	 */
+	void init(void);
+
+	/**
+	 * @brief Get the UART for a serial port, initializing it on first use
+	 *
+	 * @param port The serial port
+	 * @return The UART for the port
+	 */
+	[[nodiscard]] UART &get_port(UART::UARTPort port);
+
+	/**
+	 * @brief Get the device a file descriptor is mapped to
+	 *
+	 * @param fd The file descriptor
+	 * @return The device, or nullptr if the file descriptor is not mapped
+	 */
+	[[nodiscard]] UART *get_device(int fd);
+
+	/**
+	 * @brief Map a file descriptor to a serial port
+	 *
+	 * @param fd The file descriptor
+	 * @param port The serial port
+	 * @return true if the file descriptor was mapped successfully
+	 */
+	bool set_device(int fd, UART::UARTPort port);
+
+	/**
+	 * @brief Write to the device a file descriptor is mapped to
+	 *
+	 * @param fd The file descriptor
+	 * @param data The bytes to write
+	 * @return The number of bytes written, or -1 if the file descriptor is not mapped
+	 */
+	ssize_t write(int fd, std::span<const uint8_t> data);
+
+	/**
+	 * @brief Synchronously flush all buffered output, e.g. before halting
+	 *
+	 */
+	void flush(void);
+}
\ No newline at end of file
@@ -82,7 +82,9 @@ namespace CPU {
 		SSE4_1 = CPUID_FEATURE(1, 19, CPUID_ECX),
 		SSE4_2 = CPUID_FEATURE(1, 20, CPUID_ECX),
 		AVX = CPUID_FEATURE(1, 28, CPUID_ECX),
-		AVX2 = CPUID_FEATURE(7, 5, CPUID_EBX)
+		AVX2 = CPUID_FEATURE(7, 5, CPUID_EBX),
+		ERMS = CPUID_FEATURE(7, 9, CPUID_EBX),
+		FSRM = CPUID_FEATURE(7, 4, CPUID_EDX)
 	};
 	// TODO Add more features
 
@@ -153,4 +155,15 @@ namespace CPU {
 		asm volatile("pushfq; popq %0" : "=r"(flags));
 		return flags;
 	}
+
+	/**
+	 * @brief Read the Time Stamp Counter
+	 *
+	 * @return The number of cycles since reset
+	 */
+	[[nodiscard]] inline uint64_t get_tsc(void) {
+		uint32_t lo, hi;
+		asm volatile("rdtsc" : "=a"(lo), "=d"(hi));
+		return (static_cast<uint64_t>(hi) << 32) | lo;
+	}
 }
@@ -18,6 +18,7 @@ namespace Graphics::Framebuffer {
 	/**
 	 * @brief Initialize the framebuffer
 	 *
+	 * @note Registered as a deferred initcall, the other functions initialize the framebuffer on first use
 	 */
 	void init(void);
 
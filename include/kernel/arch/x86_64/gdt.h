@@ -14,6 +14,6 @@
 
 #define GDT_KCODE 0x08
 #define GDT_KDATA 0x10
-#define GDT_UCODE 0x18
-#define GDT_UDATA 0x20
+#define GDT_UDATA 0x18
+#define GDT_UCODE 0x20
 #define GDT_TSS 0x28
\ No newline at end of file
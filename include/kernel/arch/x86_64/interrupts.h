@@ -72,9 +72,10 @@ namespace Interrupts {
 	 *
 	 * @param vector The interrupt vector to set
 	 * @param handler The interrupt service routine
+	 * @param user Whether the interrupt can be invoked from user mode (i.e. using int)
 	 * @return true if the ISR was set successfully
 	 */
-	bool set_isr(uint8_t vector, void (*handler)(CPU::StackFrame *frame));
+	bool set_isr(uint8_t vector, void (*handler)(CPU::StackFrame *frame), bool user = false);
 
 	/**
 	 * @brief Removes an interrupt service routine from the IDT
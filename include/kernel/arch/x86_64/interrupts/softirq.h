@@ -0,0 +1,100 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-12
+ * @brief Deferred interrupt processing (bottom halves) and threaded IRQ handlers
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SoftIRQ {
+	/**
+	 * @brief The types of softirq that can be raised, lower values are processed first
+	 *
+	 */
+	enum class Type : uint8_t {
+		IRQ, // threaded hardware IRQ handlers, see request_irq()
+	};
+
+	/**
+	 * @brief The maximum number of softirq types
+	 *
+	 */
+	constexpr size_t MAX_SOFTIRQS = 32;
+
+	/**
+	 * @brief Initialize softirq processing and start the ksoftirqd thread
+	 *
+	 * @note Must be called after Scheduler::init()
+	 */
+	void init(void);
+
+	/**
+	 * @brief Set the handler for a softirq type
+	 *
+	 * @param type The softirq type
+	 * @param handler The handler to run when the softirq is processed
+	 * @return true if the handler was set successfully
+	 */
+	bool set_handler(Type type, void (*handler)(void));
+
+	/**
+	 * @brief Mark a softirq as pending
+	 *
+	 * @param type The softirq type to raise
+	 *
+	 * @note This function is safe to call from interrupt context, the handler will run on IRQ exit or in ksoftirqd
+	 */
+	void raise(Type type);
+
+	/**
+	 * @brief Check if any softirqs are pending on the current CPU
+	 *
+	 * @return true if any softirqs are pending
+	 */
+	[[nodiscard]] bool is_pending(void);
+
+	/**
+	 * @brief Check if the current CPU is processing softirqs
+	 *
+	 * @return true if softirqs are being processed
+	 */
+	[[nodiscard]] bool in_softirq(void);
+
+	/**
+	 * @brief Process pending softirqs, should be called at the end of a hardware interrupt handler
+	 *
+	 * @details Pending softirqs are processed in batches with interrupts enabled. If softirqs are still pending after
+	 * a bounded number of batches, the remaining work is handed to the ksoftirqd thread so that a burst of interrupts
+	 * cannot starve the interrupted thread.
+	 */
+	void irq_exit(void);
+
+	/**
+	 * @brief Request a threaded handler for a hardware IRQ
+	 *
+	 * @param irq The IRQ line (0-15)
+	 * @param handler The handler to run with interrupts enabled
+	 * @return true if the handler was installed successfully
+	 *
+	 * @details A minimal hard IRQ stub is installed at the IRQ's vector which masks the line, acknowledges the PIC and
+	 * raises Type::IRQ. The handler then runs in softirq context and the line is unmasked once it returns.
+	 */
+	bool request_irq(uint8_t irq, void (*handler)(void));
+
+	/**
+	 * @brief Remove a threaded handler for a hardware IRQ
+	 *
+	 * @param irq The IRQ line (0-15)
+	 * @return true if the handler was removed successfully
+	 */
+	bool free_irq(uint8_t irq);
+}
\ No newline at end of file
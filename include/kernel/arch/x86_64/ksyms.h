@@ -29,12 +29,14 @@ namespace KSyms {
 	/**
 	 * @brief Initialize the kernel symbol table
 	 *
+	 * @note Registered as a deferred initcall, get_symbol() initializes the table on first use
 	 */
 	void init(void);
 
 	/**
-	 * @brief Check if the kernel symbol table is available
+	 * @brief Check if the kernel symbol table has been initialized
 	 *
+	 * @note Does not initialize the table, so it is safe to call while panicking
 	 * @return true if available, false otherwise
 	 */
 	[[nodiscard]] bool is_available(void);
@@ -36,4 +36,14 @@ namespace Memory {
 	 * @param size The size of the memory block to deallocate
 	 */
 	void deallocate(void *ptr, size_t size = 0, size_t alignment = 0);
+
+	/**
+	 * @brief Try to grow a block of memory without moving it
+	 *
+	 * @param ptr A pointer to the memory to grow
+	 * @param size The current size of the memory block
+	 * @param new_size The requested size of the memory block
+	 * @return true if the block now holds at least new_size bytes, false if it is unchanged
+	 */
+	bool expand(void *ptr, size_t size, size_t new_size);
 }
\ No newline at end of file
@@ -14,5 +14,13 @@
 
 #define IA32_APIC_BASE_MSR 0x1B
 #define IA32_PAT_MSR 0x277
+#define IA32_EFER_MSR 0xC0000080
+#define IA32_STAR_MSR 0xC0000081
+#define IA32_LSTAR_MSR 0xC0000082
+#define IA32_FMASK_MSR 0xC0000084
+#define IA32_GS_BASE_MSR 0xC0000101
+#define IA32_KERNEL_GS_BASE_MSR 0xC0000102
+
+#define IA32_EFER_SCE (1 << 0)
 
 // TODO add more definitions
\ No newline at end of file
@@ -51,6 +51,24 @@ namespace Scheduler {
 	 */
 	void sleep_for(uint64_t ticks);
 
+	/**
+	 * @brief Block the current task until it is woken by another task or interrupt
+	 *
+	 * @note The caller should disable interrupts before checking its wake condition, otherwise a wake-up that arrives
+	 * between the check and the call to block() will be lost
+	 */
+	void block(void);
+
+	/**
+	 * @brief Wake a blocked task so that it can be scheduled again
+	 *
+	 * @param thread The task to wake
+	 * @return true if the task was blocked and has been woken, false otherwise
+	 *
+	 * @note This function is safe to call from interrupt context
+	 */
+	bool wake(Thread *thread);
+
 	/**
 	 * @brief Yield the current task
 	 *
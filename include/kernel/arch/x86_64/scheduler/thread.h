@@ -13,6 +13,8 @@
 #pragma once
 
 #include <cstddef>
+#include <intrusive_list>
+#include <intrusive_rbtree>
 
 #include <kernel/arch/x86_64/cpu.h>
 #include <kernel/arch/x86_64/memory/virtaddr.h>
@@ -38,6 +40,10 @@ namespace Scheduler {
 		uint64_t sleep_until;
 		CPU::State regs;
 
+		// links for the scheduler's queues, so a thread can move between them without allocating
+		std::intrusive_list_hook list_hook;
+		std::intrusive_rbtree_hook sleep_hook;
+
 		// TODO other fields
 
 		/**
@@ -64,7 +70,7 @@ namespace Scheduler {
 		/**
 		 * @brief Get the current thread
 		 *
-		 * @return A pointer to the current thread
+		 * @return A pointer to the current thread, or nullptr if the scheduler has not started
 		 */
 		static const Thread *current(void);
 	};
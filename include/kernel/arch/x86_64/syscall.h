@@ -0,0 +1,88 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-13
+ * @brief System call entry and dispatch
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <kernel/defines.h>
+
+namespace Syscall {
+	/**
+	 * @brief System call numbers
+	 *
+	 */
+	enum class Number : uint64_t {
+		NOP = 0
+	};
+
+	/**
+	 * @brief The maximum number of system calls
+	 *
+	 */
+	constexpr size_t MAX_SYSCALLS = 256;
+
+	/**
+	 * @brief The interrupt vector of the legacy system call gate
+	 *
+	 */
+	constexpr uint8_t VECTOR = 0x80;
+
+	/**
+	 * @brief Registers saved on system call entry
+	 *
+	 * @note The layout of this structure is relied upon by asm/syscall.asm
+	 */
+	struct Frame {
+		uint64_t number; // rax
+		uint64_t arg0;	 // rdi
+		uint64_t arg1;	 // rsi
+		uint64_t arg2;	 // rdx
+		uint64_t arg3;	 // r10
+		uint64_t arg4;	 // r8
+		uint64_t arg5;	 // r9
+		uint64_t rip;
+		uint64_t rflags;
+		uint64_t rsp;
+	} PACKED;
+
+	/**
+	 * @brief A system call handler
+	 *
+	 * @return The value returned to the caller in rax, negative values are errno codes
+	 */
+	typedef int64_t (*Handler)(Frame *frame);
+
+	/**
+	 * @brief Initialize the SYSCALL/SYSRET entry path and the legacy system call gate
+	 *
+	 * @note Must be called after TSS::init() and Interrupts::init()
+	 */
+	void init(void);
+
+	/**
+	 * @brief Set the handler for a system call
+	 *
+	 * @param number The system call number
+	 * @param handler The system call handler
+	 * @return true if the handler was set successfully
+	 */
+	bool set_handler(size_t number, Handler handler);
+
+	/**
+	 * @brief Set the stack switched to on system call entry
+	 *
+	 * @param rsp The top of the kernel stack
+	 */
+	void set_kernel_stack(uint64_t rsp);
+}
\ No newline at end of file
@@ -12,10 +12,39 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+#include <kernel/defines.h>
+
 namespace TSS {
+	/**
+	 * @brief Interrupt Stack Table indices, used to run critical handlers on a known good stack
+	 *
+	 */
+	enum class IST : uint8_t {
+		NONE = 0,
+		NMI = 1,
+		DOUBLE_FAULT = 2,
+		MACHINE_CHECK = 3
+	};
+
+	/**
+	 * @brief The size of each Interrupt Stack Table stack
+	 *
+	 */
+	constexpr size_t IST_STACK_SIZE = 16 * KiB;
+
 	/**
 	 * @brief Initialize the Task State Segment
 	 *
 	 */
 	void init(void);
+
+	/**
+	 * @brief Set the stack used when an interrupt arrives from user mode
+	 *
+	 * @param rsp The top of the kernel stack
+	 */
+	void set_kernel_stack(uint64_t rsp);
 }
\ No newline at end of file
@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
+#include <ring_buffer>
+#include <span>
+
 #define UART_DATA_5_BITS 0x00
 #define UART_DATA_6_BITS 0x01
 #define UART_DATA_7_BITS 0x02
@@ -26,10 +30,28 @@
 #define UART_PARITY_MARK 0x28
 #define UART_PARITY_SPACE 0x38
 
+#define UART_OFFSET_DATA 0
+#define UART_OFFSET_INTERRUPT_ENABLE 1
+#define UART_OFFSET_INTERRUPT_ID 2
+#define UART_OFFSET_FIFO_CONTROL 2
 #define UART_OFFSET_LINE_CONTROL 3
+#define UART_OFFSET_MODEM_CONTROL 4
+#define UART_OFFSET_LINE_STATUS 5
 #define UART_ENABLE_DLAB 0x80
 #define UART_MAX_BAUD_RATE 115200
 
+#define UART_IER_RX_AVAILABLE 0x01
+#define UART_IER_TX_EMPTY 0x02
+#define UART_IIR_NO_INTERRUPT 0x01
+#define UART_FCR_ENABLE_14_BYTES 0xC7
+#define UART_MCR_DTR_RTS_OUT2 0x0B
+#define UART_LSR_DATA_READY 0x01
+#define UART_LSR_TX_EMPTY 0x20
+#define UART_LSR_TX_IDLE 0x40
+
+#define UART_FIFO_SIZE 16
+#define UART_BUFFER_SIZE 1024
+
 class UART {
   public:
 	enum UARTPort : uint16_t {
@@ -48,9 +70,56 @@ class UART {
 	uint8_t read();
 	void write(uint8_t value);
 
+	/**
+	 * @brief Switch the port to interrupt driven I/O, bytes are then buffered in the RX/TX rings
+	 *
+	 * @return true if interrupts were enabled successfully
+	 */
+	bool enableInterrupts();
+
+	/**
+	 * @brief Switch the port back to polled I/O, flushing any buffered output first
+	 *
+	 */
+	void disableInterrupts();
+
+	/**
+	 * @brief Write a block of bytes, filling the whole FIFO per line status check
+	 *
+	 * @param data The bytes to write
+	 * @return The number of bytes written
+	 */
+	size_t write(std::span<const uint8_t> data);
+
+	/**
+	 * @brief Read up to count buffered bytes without blocking
+	 *
+	 * @param buffer The buffer to read into
+	 * @param count The maximum number of bytes to read
+	 * @return The number of bytes read
+	 */
+	size_t read(uint8_t *buffer, size_t count);
+
+	/**
+	 * @brief Synchronously transmit all buffered output
+	 *
+	 */
+	void flush();
+
   private:
+	// only accessed with interrupts disabled
+	using RingBuffer = std::ring_buffer<uint8_t, UART_BUFFER_SIZE>;
+
+	void handleInterrupt();
+	void transmit();
+	static void irqHandler();
+
 	UARTPort port_m;
 	uint32_t baudRate_m;
 	uint8_t protocol_m;
+	bool interrupts_m;
+	RingBuffer rx_m;
+	RingBuffer tx_m;
 	static bool portUsed_m[4];
+	static UART *instances_m[4];
 };
\ No newline at end of file
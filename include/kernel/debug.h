@@ -12,11 +12,13 @@
 
 #pragma once
 
+#include <cstdarg>
 #include <cstddef>
 
 #include <memory>
 
 #include <kernel/defines.h>
+#include <kernel/log.h>
 
 #define DEFAULT_MAX_FRAMES 32
 
@@ -24,58 +26,121 @@ namespace Debug {
 	/**
 	 * @brief Log a message to output
 	 *
+	 * @tparam category The category of the message
 	 * @param format The format string
 	 * @param ... The format arguments
 	 */
-	void log(const char *format, ...) FORMAT(printf, 1, 2);
+	template <Log::Category category = Log::Category::GENERAL>
+	FORMAT(printf, 1, 2) inline void log(const char *format, ...) {
+		if constexpr (Log::is_compiled(Log::Level::LOG)) {
+			va_list ap;
+			va_start(ap, format);
+			Log::write(Log::Level::LOG, category, format, ap);
+			va_end(ap);
+		}
+	}
 
 	/**
 	 * @brief Log a failure message to output
 	 *
+	 * @tparam category The category of the message
 	 * @param format The format string
 	 * @param ... The format arguments
 	 */
-	void log_failure(const char *format, ...) FORMAT(printf, 1, 2);
+	template <Log::Category category = Log::Category::GENERAL>
+	FORMAT(printf, 1, 2) inline void log_failure(const char *format, ...) {
+		if constexpr (Log::is_compiled(Log::Level::FAILURE)) {
+			va_list ap;
+			va_start(ap, format);
+			Log::write(Log::Level::FAILURE, category, format, ap);
+			va_end(ap);
+		}
+	}
 
 	/**
 	 * @brief Log an info message to output
 	 *
+	 * @tparam category The category of the message
 	 * @param format The format string
 	 * @param ... The format arguments
 	 */
-	void log_info(const char *format, ...) FORMAT(printf, 1, 2);
+	template <Log::Category category = Log::Category::GENERAL>
+	FORMAT(printf, 1, 2) inline void log_info(const char *format, ...) {
+		if constexpr (Log::is_compiled(Log::Level::INFO)) {
+			va_list ap;
+			va_start(ap, format);
+			Log::write(Log::Level::INFO, category, format, ap);
+			va_end(ap);
+		}
+	}
 
 	/**
 	 * @brief Log an ok message to output
 	 *
+	 * @tparam category The category of the message
 	 * @param format The format string
 	 * @param ... The format arguments
 	 */
-	void log_ok(const char *format, ...) FORMAT(printf, 1, 2);
+	template <Log::Category category = Log::Category::GENERAL>
+	FORMAT(printf, 1, 2) inline void log_ok(const char *format, ...) {
+		if constexpr (Log::is_compiled(Log::Level::OK)) {
+			va_list ap;
+			va_start(ap, format);
+			Log::write(Log::Level::OK, category, format, ap);
+			va_end(ap);
+		}
+	}
 
 	/**
 	 * @brief Log a test message to output
 	 *
+	 * @tparam category The category of the message
 	 * @param format The format string
 	 * @param ... The format arguments
 	 */
-	void log_test(const char *format, ...) FORMAT(printf, 1, 2);
+	template <Log::Category category = Log::Category::GENERAL>
+	FORMAT(printf, 1, 2) inline void log_test(const char *format, ...) {
+		if constexpr (Log::is_compiled(Log::Level::TEST)) {
+			va_list ap;
+			va_start(ap, format);
+			Log::write(Log::Level::TEST, category, format, ap);
+			va_end(ap);
+		}
+	}
 
 	/**
 	 * @brief Log a warning message to output
 	 *
+	 * @tparam category The category of the message
 	 * @param format The format string
 	 * @param ... The format arguments
 	 */
-	void log_warning(const char *format, ...) FORMAT(printf, 1, 2);
+	template <Log::Category category = Log::Category::GENERAL>
+	FORMAT(printf, 1, 2) inline void log_warning(const char *format, ...) {
+		if constexpr (Log::is_compiled(Log::Level::WARNING)) {
+			va_list ap;
+			va_start(ap, format);
+			Log::write(Log::Level::WARNING, category, format, ap);
+			va_end(ap);
+		}
+	}
 
 	/**
 	 * @brief Log a raw message to output
 	 *
+	 * @tparam category The category of the message
 	 * @param format The format string
 	 * @param ... The format arguments
 	 */
-	void log_raw(const char *format, ...) FORMAT(printf, 1, 2);
+	template <Log::Category category = Log::Category::GENERAL>
+	FORMAT(printf, 1, 2) inline void log_raw(const char *format, ...) {
+		if constexpr (Log::is_compiled(Log::Level::RAW)) {
+			va_list ap;
+			va_start(ap, format);
+			Log::write(Log::Level::RAW, category, format, ap);
+			va_end(ap);
+		}
+	}
 
 	/**
 	 * @brief Print a stack trace to output
@@ -0,0 +1,92 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-17
+ * @brief Initcall framework for dependency ordered, parallel and deferred subsystem initialization
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <kernel/defines.h>
+
+/**
+ * @brief Register an initcall
+ *
+ * @param name The name of the initcall, used by dependencies and require()
+ * @param func The function to call
+ * @param mode The Initcall::Mode of the initcall
+ * @param ... The names of the initcalls that must finish first, as string literals
+ */
+#define INITCALL(name, func, mode, ...) \
+	USED SECTION(".initcalls") static constinit const Initcall::Entry __initcall_##name = {#name, func, mode, {__VA_ARGS__}}
+
+namespace Initcall {
+	/**
+	 * @brief The maximum number of initcalls that can be registered
+	 *
+	 */
+	constexpr size_t MAX_INITCALLS = 32;
+
+	/**
+	 * @brief The maximum number of dependencies a single initcall can declare
+	 *
+	 */
+	constexpr size_t MAX_DEPENDENCIES = 4;
+
+	/**
+	 * @brief The number of worker threads used to run parallel initcalls
+	 *
+	 */
+	constexpr size_t WORKER_COUNT = 2;
+
+	/**
+	 * @brief When an initcall is run
+	 *
+	 */
+	enum class Mode {
+		PARALLEL, // run by a worker thread during run() once its dependencies are done
+		DEFERRED  // run on first use by require()
+	};
+
+	/**
+	 * @brief A registered initcall, see INITCALL()
+	 *
+	 */
+	struct Entry {
+		const char *name;
+		void (*func)(void);
+		Mode mode;
+		const char *depends[MAX_DEPENDENCIES];
+	};
+
+	/**
+	 * @brief Run all parallel initcalls on worker threads
+	 *
+	 * @note Must be called from a thread, returns once every parallel initcall has finished
+	 */
+	void run(void);
+
+	/**
+	 * @brief Ensure an initcall and its dependencies have run, running them on the calling thread if they have not
+	 *
+	 * @param name The name of the initcall
+	 * @return true if the initcall has finished, false if it is unknown or is running elsewhere and the caller cannot
+	 * wait for it (e.g. interrupts are disabled)
+	 */
+	bool require(const char *name);
+
+	/**
+	 * @brief Check if an initcall has finished
+	 *
+	 * @param name The name of the initcall
+	 * @return true if the initcall has finished, false otherwise
+	 */
+	[[nodiscard]] bool is_done(const char *name);
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-15
+ * @brief Per-CPU kernel log ring buffer
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <kernel/defines.h>
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL 0
+#endif
+
+namespace Log {
+	/**
+	 * @brief The level of a log record, in increasing order of severity
+	 *
+	 */
+	enum class Level : uint8_t {
+		LOG,
+		INFO,
+		OK,
+		TEST,
+		WARNING,
+		FAILURE,
+		RAW // written without a prefix or trailing newline
+	};
+
+	/**
+	 * @brief The subsystem a log record belongs to, each has its own runtime threshold
+	 *
+	 */
+	enum class Category : uint8_t {
+		GENERAL,
+		BOOT,
+		INTERRUPTS,
+		MEMORY,
+		SCHEDULER,
+		DEVICES,
+		COUNT
+	};
+
+	/**
+	 * @brief The minimum level compiled into the kernel, set with -DLOG_LEVEL
+	 *
+	 * @note Calls below this level are discarded at compile time
+	 */
+	constexpr Level COMPILE_LEVEL = static_cast<Level>(LOG_LEVEL);
+
+	/**
+	 * @brief The maximum number of arguments a binary record can hold
+	 *
+	 */
+	constexpr size_t MAX_BINARY_ARGS = 8;
+
+	/**
+	 * @brief The size of a single log record
+	 *
+	 */
+	constexpr size_t RECORD_SIZE = 256;
+
+	/**
+	 * @brief The number of records in each CPU's ring buffer
+	 *
+	 */
+	constexpr size_t RING_SIZE = 128;
+
+	/**
+	 * @brief A single timestamped log record
+	 *
+	 */
+	struct Record {
+		uint64_t timestamp; // TSC at the time of logging
+		uint32_t cpu;
+		uint32_t thread; // 0 before the scheduler has started
+		uint16_t length;
+		Level level;
+		Category category;
+		bool binary; // message holds a BinaryPayload instead of text
+		char message[RECORD_SIZE - 21];
+	} PACKED;
+
+	/**
+	 * @brief The contents of a binary record, formatted only when the record is written out
+	 *
+	 */
+	struct BinaryPayload {
+		const char *format;
+		uint64_t args[MAX_BINARY_ARGS];
+	};
+
+	static_assert(sizeof(BinaryPayload) <= sizeof(Record::message));
+
+	static_assert(sizeof(Record) == RECORD_SIZE);
+
+	/**
+	 * @brief Start the thread that drains the log ring buffers
+	 *
+	 * @note Must be called after Scheduler::init(), until then records are written synchronously
+	 */
+	void init(void);
+
+	/**
+	 * @brief Check if a level is compiled into the kernel
+	 *
+	 * @param level The level to check
+	 * @return true if messages of the level are compiled in
+	 */
+	constexpr bool is_compiled(Level level) {
+		return level >= COMPILE_LEVEL;
+	}
+
+	/**
+	 * @brief Set the runtime threshold of a category
+	 *
+	 * @param category The category
+	 * @param level The minimum level to log
+	 */
+	void set_level(Category category, Level level);
+
+	/**
+	 * @brief Set the runtime threshold of all categories
+	 *
+	 * @param level The minimum level to log
+	 */
+	void set_level(Level level);
+
+	/**
+	 * @brief Get the runtime threshold of a category
+	 *
+	 * @param category The category
+	 * @return The minimum level that is logged
+	 */
+	[[nodiscard]] Level get_level(Category category);
+
+	/**
+	 * @brief Format a message and append it to the current CPU's log ring buffer
+	 *
+	 * @param level The level of the message
+	 * @param category The category of the message
+	 * @param format The format string
+	 * @param ap The format arguments
+	 *
+	 * @note This function never blocks, if the ring buffer is full it falls back to writing synchronously
+	 */
+	void write(Level level, Category category, const char *format, va_list ap);
+
+	/**
+	 * @brief Append a binary record holding the format string and raw arguments, formatting is deferred to the reader
+	 *
+	 * @param level The level of the message
+	 * @param category The category of the message
+	 * @param format The format string, must outlive the record (e.g. a string literal)
+	 * @param args The raw arguments
+	 * @param count The number of arguments
+	 */
+	void write_binary(Level level, Category category, const char *format, const uint64_t *args, size_t count);
+
+	/**
+	 * @brief Convert an argument of a binary record to its raw value
+	 *
+	 * @tparam T The type of the argument
+	 * @param value The argument
+	 * @return The raw value
+	 */
+	template <typename T>
+	ALWAYS_INLINE uint64_t __to_arg(T value) {
+		if constexpr (std::is_pointer_v<T>) {
+			return reinterpret_cast<uintptr_t>(value);
+		} else {
+			return static_cast<uint64_t>(value);
+		}
+	}
+
+	/**
+	 * @brief Check if a type can be stored as an argument of a binary record
+	 *
+	 * @note Strings are rejected, only the pointer is copied and it is dereferenced when the record is written out
+	 */
+	template <typename T>
+	constexpr bool __is_trace_arg = std::is_integral_v<T> || std::is_enum_v<T> ||
+									(std::is_pointer_v<T> && !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>);
+
+	/**
+	 * @brief Log a message as a binary record, which costs little more than copying the arguments
+	 *
+	 * @tparam level The level of the message
+	 * @tparam Args The argument types, only integers, enums and non-string pointers are supported
+	 * @param category The category of the message
+	 * @param format The format string, must outlive the record (e.g. a string literal)
+	 * @param args The arguments
+	 */
+	template <Level level, typename... Args>
+	ALWAYS_INLINE void trace(Category category, const char *format, Args... args)
+		requires(sizeof...(Args) <= MAX_BINARY_ARGS && (__is_trace_arg<Args> && ...))
+	{
+		if constexpr (is_compiled(level)) {
+			uint64_t values[] = {__to_arg(args)..., 0};
+			write_binary(level, category, format, values, sizeof...(Args));
+		}
+	}
+
+	/**
+	 * @brief Synchronously write out all committed records
+	 *
+	 */
+	void flush(void);
+
+	/**
+	 * @brief Flush the ring buffers and bypass them from now on, used when the kernel panics
+	 *
+	 */
+	void set_synchronous(void);
+}
\ No newline at end of file
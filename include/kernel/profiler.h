@@ -0,0 +1,93 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-16
+ * @brief TSC based profiler for timing boot phases
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+
+namespace Profiler {
+	/**
+	 * @brief The maximum number of phases that can be recorded
+	 *
+	 */
+	constexpr size_t MAX_PHASES = 64;
+
+	/**
+	 * @brief Start timing a phase, phases started on the same thread before this one ends are nested under it
+	 *
+	 * @param name The name of the phase, must outlive the profiler (e.g. a string literal)
+	 * @return The index of the phase, or MAX_PHASES if no more phases can be recorded
+	 */
+	size_t begin(const char *name);
+
+	/**
+	 * @brief Stop timing a phase
+	 *
+	 * @param index The index returned by begin()
+	 */
+	void end(size_t index);
+
+	/**
+	 * @brief Log a table of all recorded phases
+	 *
+	 */
+	void dump(void);
+
+	/**
+	 * @brief Times a phase for as long as it is in scope
+	 *
+	 */
+	class Scope {
+	  private:
+		size_t _index;
+
+	  public:
+		/**
+		 * @brief Construct a new Profiler::Scope object and start timing a phase
+		 *
+		 * @param name The name of the phase
+		 */
+		Scope(const char *name) : _index(begin(name)) {}
+
+		// disallow copy constructor
+		Scope(const Scope &) = delete;
+
+		// disallow assignment
+		Scope &operator=(const Scope &) = delete;
+
+		/**
+		 * @brief Destroy the Profiler::Scope object and stop timing the phase
+		 *
+		 */
+		~Scope() {
+			end(_index);
+		}
+	};
+
+	/**
+	 * @brief Time a function call as a phase
+	 *
+	 * @tparam Func The type of the function
+	 * @tparam Args The types of the arguments
+	 * @param name The name of the phase
+	 * @param func The function to call
+	 * @param args The arguments to pass to the function
+	 */
+	template <typename Func, typename... Args>
+	inline void measure(const char *name, Func &&func, Args &&...args) {
+		Scope scope(name);
+		std::invoke(std::forward<Func>(func), std::forward<Args>(args)...);
+	}
+}
\ No newline at end of file
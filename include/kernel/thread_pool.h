@@ -0,0 +1,64 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-18
+ * @brief Pool of kernel worker threads for running short tasks in parallel
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+
+namespace ThreadPool {
+	/**
+	 * @brief The number of worker threads in the pool
+	 *
+	 */
+	constexpr size_t WORKER_COUNT = 2;
+
+	/**
+	 * @brief A unit of work, owned by the submitter and linked into the pool while it is queued
+	 *
+	 */
+	struct Task {
+		/**
+		 * @brief The state of a task
+		 *
+		 */
+		enum class State : uint8_t {
+			IDLE,
+			QUEUED,
+			RUNNING,
+			DONE
+		};
+
+		void (*func)(void *);
+		void *arg;
+		Task *next = nullptr;
+		std::atomic<State> state = State::IDLE;
+	};
+
+	/**
+	 * @brief Queue a task to be run by a worker thread
+	 *
+	 * @param task The task to run, must stay alive until wait() returns
+	 *
+	 * @note The task is run immediately on the calling thread if the scheduler has not started
+	 */
+	void submit(Task &task);
+
+	/**
+	 * @brief Wait for a submitted task to finish, running it on the calling thread if no worker has picked it up
+	 *
+	 * @param task The task to wait for
+	 */
+	void wait(Task &task);
+}
\ No newline at end of file
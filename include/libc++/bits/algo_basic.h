@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include <utility>
 
 namespace std {
@@ -93,10 +95,76 @@ namespace std {
 		return dest_last;
 	}
 
-	// TODO copy
+	namespace __detail {
+		// a range of IterIn can be copied to IterOut with memmove
+		template <typename IterIn, typename IterOut>
+		inline constexpr bool __is_memmove_copyable =
+			is_pointer_v<IterIn> && is_pointer_v<IterOut> &&
+			is_same_v<remove_const_t<remove_pointer_t<IterIn>>, remove_pointer_t<IterOut>> &&
+			is_trivially_copyable_v<remove_pointer_t<IterOut>>;
+	}
+
+	/**
+	 * @brief Copies the elements in the range [src_first, src_last) to another range beginning at dest_first
+	 *
+	 * @tparam IterIn The type of the input iterator
+	 * @tparam IterOut The type of the output iterator
+	 * @param src_first The beginning of the source range
+	 * @param src_last The end of the source range
+	 * @param dest_first The beginning of the destination range
+	 * @return The end of the destination range
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/copy @endlink
+	 */
+	template <typename IterIn, typename IterOut>
+	constexpr IterOut copy(IterIn src_first, IterIn src_last, IterOut dest_first) {
+		if constexpr (__detail::__is_memmove_copyable<IterIn, IterOut>) {
+			if (!is_constant_evaluated()) {
+				auto count = src_last - src_first;
+				if (count > 0) {
+					__builtin_memmove(dest_first, src_first, count * sizeof(*src_first));
+				}
+				return dest_first + count;
+			}
+		}
+		while (src_first != src_last) {
+			*dest_first++ = *src_first++;
+		}
+		return dest_first;
+	}
+
+	/**
+	 * @brief Copies count elements from a range beginning at src_first to another range beginning at dest_first
+	 *
+	 * @tparam IterIn The type of the input iterator
+	 * @tparam Size The type of the count
+	 * @tparam IterOut The type of the output iterator
+	 * @param src_first The beginning of the source range
+	 * @param count The number of elements to copy
+	 * @param dest_first The beginning of the destination range
+	 * @return The end of the destination range
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/copy_n @endlink
+	 */
+	template <typename IterIn, typename Size, typename IterOut>
+	constexpr IterOut copy_n(IterIn src_first, Size count, IterOut dest_first) {
+		if (count <= 0) {
+			return dest_first;
+		}
+		if constexpr (__detail::__is_memmove_copyable<IterIn, IterOut>) {
+			if (!is_constant_evaluated()) {
+				__builtin_memmove(dest_first, src_first, count * sizeof(*src_first));
+				return dest_first + count;
+			}
+		}
+		for (Size i = 0; i < count; i++) {
+			*dest_first++ = *src_first++;
+		}
+		return dest_first;
+	}
+
 	// TODO copy_backward
 	// TODO copy_if
-	// TODO copy_n
 
 	/**
 	 * @brief Swaps the values of two elements
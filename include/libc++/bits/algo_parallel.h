@@ -0,0 +1,146 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-18
+ * @brief Parallel versions of the algorithms, run on the kernel thread pool
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <bits/algo_sort.h>
+#include <execution>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+#include <kernel/thread_pool.h>
+
+namespace std {
+	namespace __detail {
+		// ranges smaller than this are not worth handing to another thread
+		constexpr ptrdiff_t __parallel_sort_threshold = 4096;
+
+		template <typename Iter, typename Compare>
+		void __parallel_introsort(Iter first, Iter last, Compare &comp, int bad_allowed, bool leftmost, int splits);
+
+		/**
+		 * @brief Arguments of a parallel sort of a subrange
+		 *
+		 */
+		template <typename Iter, typename Compare>
+		struct __parallel_sort_args {
+			Iter first;
+			Iter last;
+			Compare comp;
+			int bad_allowed;
+			bool leftmost;
+			int splits;
+
+			static void run(void *arg) {
+				auto &args = *static_cast<__parallel_sort_args *>(arg);
+				__parallel_introsort(args.first, args.last, args.comp, args.bad_allowed, args.leftmost, args.splits);
+			}
+		};
+
+		/**
+		 * @brief Partition the range and sort the left side on the thread pool while this thread sorts the right
+		 *
+		 * @param splits The number of times the range may still be split across threads
+		 */
+		template <typename Iter, typename Compare>
+		void __parallel_introsort(Iter first, Iter last, Compare &comp, int bad_allowed, bool leftmost, int splits) {
+			if (splits == 0 || last - first < __parallel_sort_threshold) {
+				__introsort(first, last, comp, bad_allowed, leftmost);
+				return;
+			}
+
+			__choose_pivot(first, last, comp);
+			if (!leftmost && !std::invoke(comp, *(first - 1), *first)) {
+				__introsort(__partition_left(first, last, comp) + 1, last, comp, bad_allowed, false);
+				return;
+			}
+
+			auto size = last - first;
+			auto pivot_pos = __partition_right(first, last, comp).first;
+			if (pivot_pos - first < size / 8 || last - (pivot_pos + 1) < size / 8) {
+				// not worth splitting, let the sequential sort deal with the bad pivot
+				if (--bad_allowed == 0) {
+					__make_heap(first, last, comp);
+					__sort_heap(first, last, comp);
+					return;
+				}
+				__break_patterns(first, pivot_pos);
+				__break_patterns(pivot_pos + 1, last);
+				__introsort(first, pivot_pos, comp, bad_allowed, leftmost);
+				__introsort(pivot_pos + 1, last, comp, bad_allowed, false);
+				return;
+			}
+
+			// the two sides are disjoint and the pivot between them is never moved again
+			__parallel_sort_args<Iter, Compare> args{first, pivot_pos, comp, bad_allowed, leftmost, splits - 1};
+			ThreadPool::Task task{__parallel_sort_args<Iter, Compare>::run, &args};
+			ThreadPool::submit(task);
+			__parallel_introsort(pivot_pos + 1, last, comp, bad_allowed, false, splits - 1);
+			ThreadPool::wait(task);
+		}
+
+		template <typename Iter, typename Compare>
+		void __parallel_sort(Iter first, Iter last, Compare &comp) {
+			if (last - first > 1) {
+				// split into about twice as many pieces as there are workers to even out the load
+				int splits = __log2(ThreadPool::WORKER_COUNT) + 2;
+				__parallel_introsort(first, last, comp, __log2(last - first), true, splits);
+			}
+		}
+	}
+
+	/**
+	 * @brief Sorts the range [first, last) using the given execution policy, the order of equal elements is not
+	 * preserved
+	 *
+	 * @tparam Policy The type of the execution policy
+	 * @tparam Iter The type of the iterator
+	 * @tparam Compare The type of the comparison function
+	 * @param policy The execution policy
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 * @param comp The comparison function
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/sort @endlink
+	 */
+	template <typename Policy, typename Iter, typename Compare,
+			  typename = std::enable_if_t<std::is_execution_policy_v<std::remove_cvref_t<Policy>>>>
+	inline void sort(Policy &&, Iter first, Iter last, Compare comp) {
+		if constexpr (__detail::__is_parallel_policy_v<Policy>) {
+			__detail::__parallel_sort(first, last, comp);
+		} else {
+			__detail::__sort(first, last, comp);
+		}
+	}
+
+	/**
+	 * @brief Sorts the range [first, last) using the given execution policy, the order of equal elements is not
+	 * preserved
+	 *
+	 * @tparam Policy The type of the execution policy
+	 * @tparam Iter The type of the iterator
+	 * @param policy The execution policy
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/sort @endlink
+	 */
+	template <typename Policy, typename Iter,
+			  typename = std::enable_if_t<std::is_execution_policy_v<std::remove_cvref_t<Policy>>>>
+	inline void sort(Policy &&policy, Iter first, Iter last) {
+		std::sort(std::forward<Policy>(policy), first, last,
+				  std::less<typename std::iterator_traits<Iter>::value_type>());
+	}
+}
\ No newline at end of file
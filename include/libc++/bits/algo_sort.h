@@ -0,0 +1,588 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-18
+ * @brief Various algorithms for sorting ranges
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <bits/algo_basic.h>
+#include <bits/algo_heap.h>
+#include <bits/allocator.h>
+#include <bits/construct.h>
+#include <functional>
+#include <iterator>
+#include <pair>
+
+namespace std {
+	namespace __detail {
+		// ranges smaller than this are insertion sorted
+		constexpr ptrdiff_t __insertion_sort_threshold = 24;
+
+		// ranges larger than this use the median of three medians (Tukey's ninther) as the pivot
+		constexpr ptrdiff_t __ninther_threshold = 128;
+
+		// the number of element moves allowed before an optimistic insertion sort gives up
+		constexpr ptrdiff_t __partial_insertion_sort_limit = 8;
+
+		/**
+		 * @brief Get the floor of the base 2 logarithm of a positive number
+		 *
+		 * @param n The number
+		 * @return The logarithm
+		 */
+		constexpr int __log2(size_t n) {
+			return 63 - __builtin_clzll(n);
+		}
+
+		template <typename Iter, typename Compare>
+		constexpr void __sort2(Iter a, Iter b, Compare &comp) {
+			if (std::invoke(comp, *b, *a)) {
+				std::iter_swap(a, b);
+			}
+		}
+
+		template <typename Iter, typename Compare>
+		constexpr void __sort3(Iter a, Iter b, Iter c, Compare &comp) {
+			__sort2(a, b, comp);
+			__sort2(b, c, comp);
+			__sort2(a, b, comp);
+		}
+
+		template <typename Iter, typename Compare>
+		constexpr void __insertion_sort(Iter first, Iter last, Compare &comp) {
+			if (first == last) {
+				return;
+			}
+
+			for (auto cur = first + 1; cur != last; ++cur) {
+				auto sift = cur;
+				auto prev = cur - 1;
+				if (std::invoke(comp, *sift, *prev)) {
+					auto value = std::move(*sift);
+					do {
+						*sift-- = std::move(*prev);
+					} while (sift != first && std::invoke(comp, value, *--prev));
+					*sift = std::move(value);
+				}
+			}
+		}
+
+		/**
+		 * @brief Insertion sort without a bounds check, *(first - 1) must not be greater than any element in the range
+		 *
+		 */
+		template <typename Iter, typename Compare>
+		constexpr void __unguarded_insertion_sort(Iter first, Iter last, Compare &comp) {
+			if (first == last) {
+				return;
+			}
+
+			for (auto cur = first + 1; cur != last; ++cur) {
+				auto sift = cur;
+				auto prev = cur - 1;
+				if (std::invoke(comp, *sift, *prev)) {
+					auto value = std::move(*sift);
+					do {
+						*sift-- = std::move(*prev);
+					} while (std::invoke(comp, value, *--prev));
+					*sift = std::move(value);
+				}
+			}
+		}
+
+		/**
+		 * @brief Insertion sort that gives up after a few moves, used on ranges that are probably already sorted
+		 *
+		 * @return true if the range was sorted, false if it gave up
+		 */
+		template <typename Iter, typename Compare>
+		constexpr bool __partial_insertion_sort(Iter first, Iter last, Compare &comp) {
+			if (first == last) {
+				return true;
+			}
+
+			ptrdiff_t moves = 0;
+			for (auto cur = first + 1; cur != last; ++cur) {
+				if (moves > __partial_insertion_sort_limit) {
+					return false;
+				}
+
+				auto sift = cur;
+				auto prev = cur - 1;
+				if (std::invoke(comp, *sift, *prev)) {
+					auto value = std::move(*sift);
+					do {
+						*sift-- = std::move(*prev);
+					} while (sift != first && std::invoke(comp, value, *--prev));
+					*sift = std::move(value);
+					moves += cur - sift;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Partition around the pivot at *first, elements equal to the pivot go to the right
+		 *
+		 * @return The position of the pivot, and whether the range was already partitioned
+		 */
+		template <typename Iter, typename Compare>
+		constexpr std::pair<Iter, bool> __partition_right(Iter first, Iter last, Compare &comp) {
+			auto pivot = std::move(*first);
+			auto left = first;
+			auto right = last;
+
+			// the pivot was chosen as a median, so there is an element >= pivot to stop the first scan
+			while (std::invoke(comp, *++left, pivot)) {
+			}
+			if (left - 1 == first) {
+				while (left < right && !std::invoke(comp, *--right, pivot)) {
+				}
+			} else {
+				while (!std::invoke(comp, *--right, pivot)) {
+				}
+			}
+
+			bool already_partitioned = left >= right;
+			while (left < right) {
+				std::iter_swap(left, right);
+				while (std::invoke(comp, *++left, pivot)) {
+				}
+				while (!std::invoke(comp, *--right, pivot)) {
+				}
+			}
+
+			auto pivot_pos = left - 1;
+			*first = std::move(*pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return {pivot_pos, already_partitioned};
+		}
+
+		/**
+		 * @brief Partition around the pivot at *first, elements equal to the pivot go to the left
+		 *
+		 * @return The position of the pivot
+		 *
+		 * @note Used when the pivot equals the previous pivot, so the left side will not need sorting
+		 */
+		template <typename Iter, typename Compare>
+		constexpr Iter __partition_left(Iter first, Iter last, Compare &comp) {
+			auto pivot = std::move(*first);
+			auto left = first;
+			auto right = last;
+
+			while (std::invoke(comp, pivot, *--right)) {
+			}
+			if (right + 1 == last) {
+				while (left < right && !std::invoke(comp, pivot, *++left)) {
+				}
+			} else {
+				while (!std::invoke(comp, pivot, *++left)) {
+				}
+			}
+
+			while (left < right) {
+				std::iter_swap(left, right);
+				while (std::invoke(comp, pivot, *--right)) {
+				}
+				while (!std::invoke(comp, pivot, *++left)) {
+				}
+			}
+
+			*first = std::move(*right);
+			*right = std::move(pivot);
+			return right;
+		}
+
+		/**
+		 * @brief Move the median of a range to its first element, to be used as the pivot
+		 *
+		 */
+		template <typename Iter, typename Compare>
+		constexpr void __choose_pivot(Iter first, Iter last, Compare &comp) {
+			auto size = last - first;
+			auto half = size / 2;
+			if (size > __ninther_threshold) {
+				__sort3(first, first + half, last - 1, comp);
+				__sort3(first + 1, first + (half - 1), last - 2, comp);
+				__sort3(first + 2, first + (half + 1), last - 3, comp);
+				__sort3(first + (half - 1), first + half, first + (half + 1), comp);
+				std::iter_swap(first, first + half);
+			} else {
+				__sort3(first + half, first, last - 1, comp);
+			}
+		}
+
+		/**
+		 * @brief Swap a few elements of a badly partitioned range to break up patterns that defeat the pivot selection
+		 *
+		 */
+		template <typename Iter>
+		constexpr void __break_patterns(Iter first, Iter last) {
+			auto size = last - first;
+			if (size < __insertion_sort_threshold) {
+				return;
+			}
+
+			auto quarter = size / 4;
+			std::iter_swap(first, first + quarter);
+			std::iter_swap(last - 1, last - quarter);
+			if (size > __ninther_threshold) {
+				std::iter_swap(first + 1, first + (quarter + 1));
+				std::iter_swap(first + 2, first + (quarter + 2));
+				std::iter_swap(last - 2, last - (quarter + 1));
+				std::iter_swap(last - 3, last - (quarter + 2));
+			}
+		}
+
+		/**
+		 * @brief Pattern-defeating introsort, falls back to heap sort after too many unbalanced partitions
+		 *
+		 * @param bad_allowed The number of unbalanced partitions allowed before falling back to heap sort
+		 * @param leftmost Whether this is the leftmost range, i.e. there is no element to the left to act as a sentinel
+		 */
+		template <typename Iter, typename Compare>
+		constexpr void __introsort(Iter first, Iter last, Compare &comp, int bad_allowed, bool leftmost = true) {
+			while (true) {
+				auto size = last - first;
+				if (size < __insertion_sort_threshold) {
+					if (leftmost) {
+						__insertion_sort(first, last, comp);
+					} else {
+						__unguarded_insertion_sort(first, last, comp);
+					}
+					return;
+				}
+
+				__choose_pivot(first, last, comp);
+
+				// the pivot equals the element to its left, which is the previous pivot, so everything equal to it
+				// can be placed to the left and never looked at again
+				if (!leftmost && !std::invoke(comp, *(first - 1), *first)) {
+					first = __partition_left(first, last, comp) + 1;
+					continue;
+				}
+
+				auto [pivot_pos, already_partitioned] = __partition_right(first, last, comp);
+				auto left_size = pivot_pos - first;
+				auto right_size = last - (pivot_pos + 1);
+
+				if (left_size < size / 8 || right_size < size / 8) {
+					if (--bad_allowed == 0) {
+						__make_heap(first, last, comp);
+						__sort_heap(first, last, comp);
+						return;
+					}
+					__break_patterns(first, pivot_pos);
+					__break_patterns(pivot_pos + 1, last);
+				} else if (already_partitioned && __partial_insertion_sort(first, pivot_pos, comp) &&
+						   __partial_insertion_sort(pivot_pos + 1, last, comp)) {
+					return;
+				}
+
+				// recurse into the left side and loop on the right
+				__introsort(first, pivot_pos, comp, bad_allowed, leftmost);
+				first = pivot_pos + 1;
+				leftmost = false;
+			}
+		}
+
+		template <typename Iter, typename Compare>
+		constexpr void __sort(Iter first, Iter last, Compare &comp) {
+			if (last - first > 1) {
+				__introsort(first, last, comp, __log2(last - first));
+			}
+		}
+
+		/**
+		 * @brief Introselect, partitions until the nth element is in place, falling back to heap sort if that takes too long
+		 *
+		 */
+		template <typename Iter, typename Compare>
+		constexpr void __nth_element(Iter first, Iter nth, Iter last, Compare &comp) {
+			if (nth == last) {
+				return;
+			}
+
+			int bad_allowed = last - first > 1 ? __log2(last - first) : 0;
+			while (last - first >= __insertion_sort_threshold) {
+				__choose_pivot(first, last, comp);
+				auto pivot_pos = __partition_right(first, last, comp).first;
+				if (pivot_pos == nth) {
+					return;
+				}
+
+				auto size = last - first;
+				if (pivot_pos < nth) {
+					first = pivot_pos + 1;
+				} else {
+					last = pivot_pos;
+				}
+
+				if (last - first > size - size / 8 && --bad_allowed <= 0) {
+					__make_heap(first, last, comp);
+					__sort_heap(first, last, comp);
+					return;
+				}
+			}
+			__insertion_sort(first, last, comp);
+		}
+
+		// ranges smaller than this are insertion sorted by stable_sort
+		constexpr ptrdiff_t __merge_sort_threshold = 32;
+
+		/**
+		 * @brief Merge sort using a buffer large enough for half of the range
+		 *
+		 * @param buffer Uninitialized storage for at least (last - first + 1) / 2 elements
+		 */
+		template <typename Iter, typename Compare, typename T>
+		constexpr void __merge_sort(Iter first, Iter last, T *buffer, Compare &comp) {
+			auto size = last - first;
+			if (size <= __merge_sort_threshold) {
+				__insertion_sort(first, last, comp);
+				return;
+			}
+
+			auto middle = first + (size + 1) / 2;
+			__merge_sort(first, middle, buffer, comp);
+			__merge_sort(middle, last, buffer, comp);
+
+			// already in order, which makes sorted and reverse-merged input linear
+			if (!std::invoke(comp, *middle, *(middle - 1))) {
+				return;
+			}
+
+			// move the left half out and merge back into the range, taking from the left half on ties for stability
+			auto buffer_end = buffer;
+			for (auto it = first; it != middle; ++it, ++buffer_end) {
+				std::construct_at(buffer_end, std::move(*it));
+			}
+
+			auto left = buffer;
+			auto right = middle;
+			auto out = first;
+			while (left != buffer_end && right != last) {
+				if (std::invoke(comp, *right, *left)) {
+					*out++ = std::move(*right++);
+				} else {
+					*out++ = std::move(*left++);
+				}
+			}
+			while (left != buffer_end) {
+				*out++ = std::move(*left++);
+			}
+
+			for (auto it = buffer; it != buffer_end; ++it) {
+				std::destroy_at(it);
+			}
+		}
+
+		template <typename Iter, typename Compare>
+		constexpr void __stable_sort(Iter first, Iter last, Compare &comp) {
+			using T = typename std::iterator_traits<Iter>::value_type;
+
+			auto size = last - first;
+			if (size <= __merge_sort_threshold) {
+				__insertion_sort(first, last, comp);
+				return;
+			}
+
+			std::allocator<T> alloc;
+			auto buffer_size = static_cast<size_t>((size + 1) / 2);
+			auto buffer = alloc.allocate(buffer_size);
+			if (buffer == nullptr) {
+				// TODO buffer-less merge, insertion sort is also stable
+				__insertion_sort(first, last, comp);
+				return;
+			}
+			__merge_sort(first, last, buffer, comp);
+			alloc.deallocate(buffer, buffer_size);
+		}
+
+		template <typename Iter, typename Compare>
+		constexpr Iter __is_sorted_until(Iter first, Iter last, Compare &comp) {
+			if (first == last) {
+				return last;
+			}
+			for (auto next = first + 1; next != last; first = next, ++next) {
+				if (std::invoke(comp, *next, *first)) {
+					return next;
+				}
+			}
+			return last;
+		}
+	}
+
+	/**
+	 * @brief Sorts the range [first, last), the order of equal elements is not preserved
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @tparam Compare The type of the comparison function
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 * @param comp The comparison function
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/sort @endlink
+	 */
+	template <typename Iter, typename Compare>
+	constexpr inline void sort(Iter first, Iter last, Compare comp) {
+		__detail::__sort(first, last, comp);
+	}
+
+	/**
+	 * @brief Sorts the range [first, last), the order of equal elements is not preserved
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/sort @endlink
+	 */
+	template <typename Iter>
+	constexpr inline void sort(Iter first, Iter last) {
+		std::less<typename std::iterator_traits<Iter>::value_type> comp;
+		__detail::__sort(first, last, comp);
+	}
+
+	/**
+	 * @brief Sorts the range [first, last), the order of equal elements is preserved
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @tparam Compare The type of the comparison function
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 * @param comp The comparison function
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/stable_sort @endlink
+	 */
+	template <typename Iter, typename Compare>
+	inline void stable_sort(Iter first, Iter last, Compare comp) {
+		__detail::__stable_sort(first, last, comp);
+	}
+
+	/**
+	 * @brief Sorts the range [first, last), the order of equal elements is preserved
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/stable_sort @endlink
+	 */
+	template <typename Iter>
+	inline void stable_sort(Iter first, Iter last) {
+		std::less<typename std::iterator_traits<Iter>::value_type> comp;
+		__detail::__stable_sort(first, last, comp);
+	}
+
+	/**
+	 * @brief Partially sorts the range [first, last) so that nth holds the element that would be there if the range
+	 * was sorted, no element before nth is greater than it and no element after is less than it
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @tparam Compare The type of the comparison function
+	 * @param first The start of the range
+	 * @param nth The position to sort
+	 * @param last The end of the range
+	 * @param comp The comparison function
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/nth_element @endlink
+	 */
+	template <typename Iter, typename Compare>
+	constexpr inline void nth_element(Iter first, Iter nth, Iter last, Compare comp) {
+		__detail::__nth_element(first, nth, last, comp);
+	}
+
+	/**
+	 * @brief Partially sorts the range [first, last) so that nth holds the element that would be there if the range
+	 * was sorted, no element before nth is greater than it and no element after is less than it
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @param first The start of the range
+	 * @param nth The position to sort
+	 * @param last The end of the range
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/nth_element @endlink
+	 */
+	template <typename Iter>
+	constexpr inline void nth_element(Iter first, Iter nth, Iter last) {
+		std::less<typename std::iterator_traits<Iter>::value_type> comp;
+		__detail::__nth_element(first, nth, last, comp);
+	}
+
+	/**
+	 * @brief Finds the largest subrange in the range [first, last) that is sorted
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @tparam Compare The type of the comparison function
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 * @param comp The comparison function
+	 * @return The end of the largest sorted subrange
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/is_sorted_until @endlink
+	 */
+	template <typename Iter, typename Compare>
+	[[nodiscard]] constexpr inline Iter is_sorted_until(Iter first, Iter last, Compare comp) {
+		return __detail::__is_sorted_until(first, last, comp);
+	}
+
+	/**
+	 * @brief Finds the largest subrange in the range [first, last) that is sorted
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 * @return The end of the largest sorted subrange
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/is_sorted_until @endlink
+	 */
+	template <typename Iter>
+	[[nodiscard]] constexpr inline Iter is_sorted_until(Iter first, Iter last) {
+		std::less<typename std::iterator_traits<Iter>::value_type> comp;
+		return __detail::__is_sorted_until(first, last, comp);
+	}
+
+	/**
+	 * @brief Check if the range [first, last) is sorted
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @tparam Compare The type of the comparison function
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 * @param comp The comparison function
+	 * @return true if the range is sorted, false otherwise
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/is_sorted @endlink
+	 */
+	template <typename Iter, typename Compare>
+	[[nodiscard]] constexpr inline bool is_sorted(Iter first, Iter last, Compare comp) {
+		return __detail::__is_sorted_until(first, last, comp) == last;
+	}
+
+	/**
+	 * @brief Check if the range [first, last) is sorted
+	 *
+	 * @tparam Iter The type of the iterator
+	 * @param first The start of the range
+	 * @param last The end of the range
+	 * @return true if the range is sorted, false otherwise
+	 *
+	 * @link https://en.cppreference.com/w/cpp/algorithm/is_sorted @endlink
+	 */
+	template <typename Iter>
+	[[nodiscard]] constexpr inline bool is_sorted(Iter first, Iter last) {
+		std::less<typename std::iterator_traits<Iter>::value_type> comp;
+		return __detail::__is_sorted_until(first, last, comp) == last;
+	}
+}
\ No newline at end of file
@@ -89,6 +89,20 @@ namespace std {
 		constexpr void deallocate(T *p, size_t n) {
 			Memory::deallocate(p, n * sizeof(T));
 		}
+
+		/**
+		 * @brief Try to grow the storage referenced by the pointer p without moving it
+		 *
+		 * @param p The pointer to the storage to grow
+		 * @param n The number of objects the storage currently holds
+		 * @param new_n The number of objects the storage should hold
+		 * @return true if the storage was grown, false if it is unchanged
+		 *
+		 * @note This function is not part of the C++ standard library
+		 */
+		[[nodiscard]] constexpr bool expand(T *p, size_t n, size_t new_n) {
+			return Memory::expand(p, n * sizeof(T), new_n * sizeof(T));
+		}
 	};
 
 	/**
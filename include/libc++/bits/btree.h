@@ -0,0 +1,921 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-20
+ * @brief B-tree used by the ordered associative containers
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#include <bits/algo_basic.h>
+#include <bits/allocator.h>
+#include <bits/allocator_traits.h>
+#include <bits/construct.h>
+#include <bits/iterator_traits.h>
+#include <bits/key_extract.h>
+#include <bits/reverse_iterator.h>
+#include <cassert>
+#include <functional>
+#include <pair>
+#include <utility>
+
+namespace std {
+	namespace __detail {
+		// the target size of a node, a few cache lines so that a search within a node stays cheap while the tree stays
+		// shallow
+		constexpr size_t __btree_node_bytes = 256;
+
+		/**
+		 * @brief Get the number of values stored in each node of a B-tree
+		 *
+		 * @tparam Value The type of the values
+		 */
+		template <typename Value>
+		constexpr size_t __btree_node_values(void) {
+			// parent pointer, position, count and leaf flag, padded to the alignment of the values
+			constexpr size_t header = (sizeof(void *) + 3 + alignof(Value) - 1) / alignof(Value) * alignof(Value);
+			constexpr size_t count = (__btree_node_bytes - header) / sizeof(Value);
+			return count < 3 ? 3 : count > 255 ? 255 : count;
+		}
+
+		/**
+		 * @brief A node of a B-tree, leaves only hold values and internal nodes also hold (count + 1) children
+		 *
+		 * @tparam Value The type of the values
+		 */
+		template <typename Value>
+		struct __btree_node {
+			static constexpr size_t max_values = __btree_node_values<Value>();
+			static constexpr size_t min_values = (max_values - 1) / 2;
+
+			__btree_node *parent = nullptr;
+			uint8_t position = 0; // the index of this node in the children of its parent
+			uint8_t count = 0;
+			bool leaf;
+			union {
+				Value values[max_values];
+			};
+
+			explicit __btree_node(bool leaf) : leaf(leaf) {}
+
+			~__btree_node(void) {}
+
+			[[nodiscard]] __btree_node *&child(size_t index);
+
+			[[nodiscard]] __btree_node *child(size_t index) const;
+		};
+
+		template <typename Value>
+		struct __btree_internal : __btree_node<Value> {
+			__btree_node<Value> *children[__btree_node<Value>::max_values + 1];
+
+			__btree_internal(void) : __btree_node<Value>(false) {}
+		};
+
+		template <typename Value>
+		__btree_node<Value> *&__btree_node<Value>::child(size_t index) {
+			return static_cast<__btree_internal<Value> *>(this)->children[index];
+		}
+
+		template <typename Value>
+		__btree_node<Value> *__btree_node<Value>::child(size_t index) const {
+			return static_cast<const __btree_internal<Value> *>(this)->children[index];
+		}
+
+		template <typename Value, bool Const>
+		struct __btree_iterator {
+			using value_type = Value;
+			using pointer = std::conditional_t<Const, const Value *, Value *>;
+			using reference = std::conditional_t<Const, const Value &, Value &>;
+			using difference_type = ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			using node_t = __btree_node<Value>;
+
+			node_t *_node;
+			size_t _position;
+
+			constexpr __btree_iterator(void) = default;
+
+			constexpr __btree_iterator(node_t *node, size_t position) : _node(node), _position(position) {}
+
+			// a template, so that it does not replace the copy constructor of the mutable iterator
+			template <bool C = Const>
+				requires(C)
+			constexpr __btree_iterator(const __btree_iterator<Value, false> &other)
+				: _node(other._node), _position(other._position) {}
+
+			/**
+			 * @brief Climb out of nodes whose values have all been visited, the end of the tree is the position after
+			 * the last value of the root
+			 *
+			 */
+			constexpr void __climb(void) {
+				while (_position == _node->count && _node->parent != nullptr) {
+					_position = _node->position;
+					_node = _node->parent;
+				}
+			}
+
+			[[nodiscard]] constexpr reference operator*(void) const {
+				return _node->values[_position];
+			}
+
+			[[nodiscard]] constexpr pointer operator->(void) const {
+				return &_node->values[_position];
+			}
+
+			constexpr __btree_iterator &operator++(void) {
+				if (_node->leaf) {
+					_position++;
+					__climb();
+				} else {
+					// the leftmost value of the subtree to the right
+					_node = _node->child(_position + 1);
+					while (!_node->leaf) {
+						_node = _node->child(0);
+					}
+					_position = 0;
+				}
+				return *this;
+			}
+
+			constexpr __btree_iterator operator++(int) {
+				auto tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			constexpr __btree_iterator &operator--(void) {
+				if (_node->leaf) {
+					while (_position == 0 && _node->parent != nullptr) {
+						_position = _node->position;
+						_node = _node->parent;
+					}
+					_position--;
+				} else {
+					// the rightmost value of the subtree to the left
+					_node = _node->child(_position);
+					while (!_node->leaf) {
+						_node = _node->child(_node->count);
+					}
+					_position = _node->count - 1;
+				}
+				return *this;
+			}
+
+			constexpr __btree_iterator operator--(int) {
+				auto tmp = *this;
+				--*this;
+				return tmp;
+			}
+
+			[[nodiscard]] constexpr friend bool operator==(const __btree_iterator &lhs, const __btree_iterator &rhs) {
+				return lhs._node == rhs._node && lhs._position == rhs._position;
+			}
+		};
+
+		/**
+		 * @brief B-tree with unique keys
+		 *
+		 * @details Every node holds up to max_values sorted values, sized so that a node spans a few cache lines,
+		 * instead of the one value per node of a red-black tree. Lookups binary search a node and then descend into one
+		 * of its children, so there are far fewer pointers to chase and nodes to allocate. Full leaves are split before
+		 * inserting, and nodes that drop below min_values borrow from or merge with a sibling.
+		 *
+		 * @tparam Key The type of the keys
+		 * @tparam Value The type of the stored values
+		 * @tparam KeyOf Function object that gets the key of a value
+		 * @tparam Compare The key comparison function object
+		 * @tparam A The allocator type
+		 */
+		template <typename Key, typename Value, typename KeyOf, typename Compare, typename A>
+		class __btree {
+		  public:
+			using key_type = Key;
+			using value_type = Value;
+			using size_type = size_t;
+			using difference_type = ptrdiff_t;
+			using key_compare = Compare;
+			using allocator_type = A;
+			using reference = value_type &;
+			using const_reference = const value_type &;
+			using pointer = std::allocator_traits<A>::pointer;
+			using const_pointer = std::allocator_traits<A>::const_pointer;
+			// the values of sets are their keys, so they can never be modified through an iterator
+			using iterator = __btree_iterator<Value, std::is_same_v<Key, Value>>;
+			using const_iterator = __btree_iterator<Value, true>;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		  protected:
+			using node_t = __btree_node<Value>;
+			using internal_t = __btree_internal<Value>;
+			using leaf_alloc_t = typename std::allocator_traits<A>::rebind_alloc<node_t>;
+			using internal_alloc_t = typename std::allocator_traits<A>::rebind_alloc<internal_t>;
+
+			static constexpr size_t __max_values = node_t::max_values;
+			static constexpr size_t __min_values = node_t::min_values;
+
+			node_t *_root = nullptr;
+			size_t _size = 0;
+			[[no_unique_address]] Compare _comp;
+			[[no_unique_address]] A _alloc;
+			[[no_unique_address]] leaf_alloc_t _leaf_alloc;
+			[[no_unique_address]] internal_alloc_t _internal_alloc;
+
+			[[nodiscard]] constexpr bool __less(const Key &lhs, const Key &rhs) const {
+				return std::invoke(_comp, lhs, rhs);
+			}
+
+			[[nodiscard]] static constexpr const Key &__key(const Value &value) {
+				return KeyOf()(value);
+			}
+
+			/**
+			 * @brief Move a value into uninitialized storage and destroy the original
+			 *
+			 */
+			static constexpr void __relocate(Value *dest, Value *src) {
+				std::construct_at(dest, std::move(*src));
+				std::destroy_at(src);
+			}
+
+			/**
+			 * @brief Get the index of the first value in a node that is not less than a key
+			 *
+			 */
+			[[nodiscard]] constexpr size_t __lower_index(const node_t *node, const Key &key) const {
+				size_t low = 0;
+				size_t high = node->count;
+				while (low < high) {
+					auto mid = (low + high) / 2;
+					if (__less(__key(node->values[mid]), key)) {
+						low = mid + 1;
+					} else {
+						high = mid;
+					}
+				}
+				return low;
+			}
+
+			/**
+			 * @brief Get the index of the first value in a node that is greater than a key
+			 *
+			 */
+			[[nodiscard]] constexpr size_t __upper_index(const node_t *node, const Key &key) const {
+				size_t low = 0;
+				size_t high = node->count;
+				while (low < high) {
+					auto mid = (low + high) / 2;
+					if (__less(key, __key(node->values[mid]))) {
+						high = mid;
+					} else {
+						low = mid + 1;
+					}
+				}
+				return low;
+			}
+
+			[[nodiscard]] constexpr node_t *__new_node(bool leaf) {
+				if (leaf) {
+					auto node = _leaf_alloc.allocate(1);
+					assert(node);
+					return std::construct_at(node, true);
+				}
+				auto node = _internal_alloc.allocate(1);
+				assert(node);
+				return std::construct_at(node);
+			}
+
+			constexpr void __delete_node(node_t *node) {
+				if (node->leaf) {
+					std::destroy_at(node);
+					_leaf_alloc.deallocate(node, 1);
+				} else {
+					auto internal = static_cast<internal_t *>(node);
+					std::destroy_at(internal);
+					_internal_alloc.deallocate(internal, 1);
+				}
+			}
+
+			/**
+			 * @brief Destroy a subtree and all of its values
+			 *
+			 */
+			constexpr void __destroy(node_t *node) {
+				if (node == nullptr) {
+					return;
+				}
+				if (!node->leaf) {
+					for (size_t i = 0; i <= node->count; i++) {
+						__destroy(node->child(i));
+					}
+				}
+				for (size_t i = 0; i < node->count; i++) {
+					std::destroy_at(&node->values[i]);
+				}
+				__delete_node(node);
+			}
+
+			/**
+			 * @brief Set the child of an internal node and update the child's parent link
+			 *
+			 */
+			static constexpr void __set_child(node_t *node, size_t index, node_t *child) {
+				node->child(index) = child;
+				child->parent = node;
+				child->position = static_cast<uint8_t>(index);
+			}
+
+			/**
+			 * @brief Split a full node in two around its middle value, which moves up into the parent
+			 *
+			 * @note A full parent is split first, so splits can propagate up to the root
+			 */
+			constexpr void __split(node_t *node) {
+				if (node->parent == nullptr) {
+					auto root = __new_node(false);
+					__set_child(root, 0, node);
+					_root = root;
+				} else if (node->parent->count == __max_values) {
+					__split(node->parent);
+				}
+
+				auto parent = node->parent;
+				auto index = node->position;
+				auto sibling = __new_node(node->leaf);
+				auto mid = __max_values / 2;
+
+				// the upper half moves to the new sibling
+				sibling->count = static_cast<uint8_t>(__max_values - mid - 1);
+				for (size_t i = 0; i < sibling->count; i++) {
+					__relocate(&sibling->values[i], &node->values[mid + 1 + i]);
+				}
+				if (!node->leaf) {
+					for (size_t i = 0; i <= sibling->count; i++) {
+						__set_child(sibling, i, node->child(mid + 1 + i));
+					}
+				}
+
+				// make room in the parent for the middle value and the new sibling
+				for (size_t i = parent->count; i > index; i--) {
+					__relocate(&parent->values[i], &parent->values[i - 1]);
+					__set_child(parent, i + 1, parent->child(i));
+				}
+				__relocate(&parent->values[index], &node->values[mid]);
+				__set_child(parent, index + 1, sibling);
+				parent->count++;
+				node->count = static_cast<uint8_t>(mid);
+			}
+
+			/**
+			 * @brief Move the value from the parent and the last value of the left sibling into the front of a node
+			 *
+			 */
+			constexpr void __rotate_right(node_t *left, node_t *node) {
+				auto parent = node->parent;
+				auto index = left->position;
+
+				for (size_t i = node->count; i > 0; i--) {
+					__relocate(&node->values[i], &node->values[i - 1]);
+				}
+				__relocate(&node->values[0], &parent->values[index]);
+				__relocate(&parent->values[index], &left->values[left->count - 1]);
+
+				if (!node->leaf) {
+					for (size_t i = node->count + 1; i > 0; i--) {
+						__set_child(node, i, node->child(i - 1));
+					}
+					__set_child(node, 0, left->child(left->count));
+				}
+				left->count--;
+				node->count++;
+			}
+
+			/**
+			 * @brief Move the value from the parent and the first value of the right sibling onto the end of a node
+			 *
+			 */
+			constexpr void __rotate_left(node_t *node, node_t *right) {
+				auto parent = node->parent;
+				auto index = node->position;
+
+				__relocate(&node->values[node->count], &parent->values[index]);
+				__relocate(&parent->values[index], &right->values[0]);
+				for (size_t i = 1; i < right->count; i++) {
+					__relocate(&right->values[i - 1], &right->values[i]);
+				}
+
+				if (!node->leaf) {
+					__set_child(node, node->count + 1, right->child(0));
+					for (size_t i = 1; i <= right->count; i++) {
+						__set_child(right, i - 1, right->child(i));
+					}
+				}
+				right->count--;
+				node->count++;
+			}
+
+			/**
+			 * @brief Merge a node, the value between them in the parent and the right sibling into the node
+			 *
+			 */
+			constexpr void __merge(node_t *node, node_t *right) {
+				auto parent = node->parent;
+				auto index = node->position;
+
+				__relocate(&node->values[node->count], &parent->values[index]);
+				for (size_t i = 0; i < right->count; i++) {
+					__relocate(&node->values[node->count + 1 + i], &right->values[i]);
+				}
+				if (!node->leaf) {
+					for (size_t i = 0; i <= right->count; i++) {
+						__set_child(node, node->count + 1 + i, right->child(i));
+					}
+				}
+				node->count = static_cast<uint8_t>(node->count + 1 + right->count);
+				right->count = 0;
+				__delete_node(right);
+
+				for (size_t i = index + 1; i < parent->count; i++) {
+					__relocate(&parent->values[i - 1], &parent->values[i]);
+					__set_child(parent, i, parent->child(i + 1));
+				}
+				parent->count--;
+			}
+
+			/**
+			 * @brief Restore the minimum fill of a node after a value was removed from it
+			 *
+			 */
+			constexpr void __rebalance(node_t *node) {
+				while (node->parent != nullptr && node->count < __min_values) {
+					auto parent = node->parent;
+					auto index = node->position;
+					auto left = index > 0 ? parent->child(index - 1) : nullptr;
+					auto right = index < parent->count ? parent->child(index + 1) : nullptr;
+
+					if (left && left->count > __min_values) {
+						__rotate_right(left, node);
+						return;
+					}
+					if (right && right->count > __min_values) {
+						__rotate_left(node, right);
+						return;
+					}
+
+					if (left) {
+						__merge(left, node);
+					} else {
+						__merge(node, right);
+					}
+					node = parent;
+				}
+
+				if (_root->count == 0) {
+					auto old_root = _root;
+					if (_root->leaf) {
+						_root = nullptr;
+					} else {
+						_root = _root->child(0);
+						_root->parent = nullptr;
+						_root->position = 0;
+					}
+					__delete_node(old_root);
+				}
+			}
+
+			/**
+			 * @brief Remove the value at an iterator
+			 *
+			 */
+			constexpr void __erase_at(node_t *node, size_t position) {
+				if (!node->leaf) {
+					// replace the value with its predecessor, which is always in a leaf
+					auto leaf = node->child(position);
+					while (!leaf->leaf) {
+						leaf = leaf->child(leaf->count);
+					}
+					std::destroy_at(&node->values[position]);
+					__relocate(&node->values[position], &leaf->values[leaf->count - 1]);
+					node = leaf;
+					position = leaf->count - 1;
+				} else {
+					std::destroy_at(&node->values[position]);
+				}
+
+				for (size_t i = position + 1; i < node->count; i++) {
+					__relocate(&node->values[i - 1], &node->values[i]);
+				}
+				node->count--;
+				_size--;
+				__rebalance(node);
+			}
+
+			/**
+			 * @brief Find a key, or prepare an empty slot for it in a leaf
+			 *
+			 * @return The position of the key, and true if the slot is new and the caller must construct a value in it
+			 */
+			constexpr std::pair<iterator, bool> __find_or_prepare(const Key &key) {
+				if (_root == nullptr) {
+					_root = __new_node(true);
+				}
+
+				while (true) {
+					auto node = _root;
+					size_t index;
+					while (true) {
+						index = __lower_index(node, key);
+						if (index < node->count && !__less(key, __key(node->values[index]))) {
+							return {iterator(node, index), false};
+						}
+						if (node->leaf) {
+							break;
+						}
+						node = node->child(index);
+					}
+
+					if (node->count == __max_values) {
+						// splitting moves values around, so search again
+						__split(node);
+						continue;
+					}
+
+					for (size_t i = node->count; i > index; i--) {
+						__relocate(&node->values[i], &node->values[i - 1]);
+					}
+					node->count++;
+					_size++;
+					return {iterator(node, index), true};
+				}
+			}
+
+			[[nodiscard]] constexpr iterator __lower_bound(const Key &key) const {
+				if (_root == nullptr) {
+					return iterator(nullptr, 0);
+				}
+
+				auto node = _root;
+				while (true) {
+					auto index = __lower_index(node, key);
+					if (node->leaf || (index < node->count && !__less(key, __key(node->values[index])))) {
+						iterator it(node, index);
+						it.__climb();
+						return it;
+					}
+					node = node->child(index);
+				}
+			}
+
+			[[nodiscard]] constexpr iterator __upper_bound(const Key &key) const {
+				if (_root == nullptr) {
+					return iterator(nullptr, 0);
+				}
+
+				auto node = _root;
+				while (true) {
+					auto index = __upper_index(node, key);
+					if (node->leaf) {
+						iterator it(node, index);
+						it.__climb();
+						return it;
+					}
+					node = node->child(index);
+				}
+			}
+
+			[[nodiscard]] constexpr iterator __find(const Key &key) const {
+				auto it = __lower_bound(key);
+				if (it == __end() || __less(key, __key(*it))) {
+					return __end();
+				}
+				return it;
+			}
+
+			[[nodiscard]] constexpr iterator __begin(void) const {
+				if (_root == nullptr) {
+					return iterator(nullptr, 0);
+				}
+				auto node = _root;
+				while (!node->leaf) {
+					node = node->child(0);
+				}
+				iterator it(node, 0);
+				it.__climb();
+				return it;
+			}
+
+			[[nodiscard]] constexpr iterator __end(void) const {
+				return iterator(_root, _root ? _root->count : 0);
+			}
+
+		  public:
+			/**
+			 * @brief Insert a value if its key is not in the tree, constructing it with a function only when needed
+			 *
+			 * @param key The key of the value
+			 * @param construct Function that constructs the value at a given pointer
+			 * @return An iterator to the value with the key, and true if it was inserted
+			 */
+			template <typename F>
+			constexpr std::pair<iterator, bool> __emplace_key(const Key &key, F &&construct) {
+				auto [it, inserted] = __find_or_prepare(key);
+				if (inserted) {
+					construct(&it._node->values[it._position]);
+				}
+				return {it, inserted};
+			}
+
+#pragma region Constructors
+			constexpr __btree(void) = default;
+
+			constexpr explicit __btree(const Compare &comp, const allocator_type &alloc = allocator_type())
+				: _comp(comp), _alloc(alloc), _leaf_alloc(alloc), _internal_alloc(alloc) {}
+
+			constexpr __btree(const __btree &other)
+				: _comp(other._comp), _alloc(other._alloc), _leaf_alloc(other._leaf_alloc),
+				  _internal_alloc(other._internal_alloc) {
+				// appending in order always inserts into the rightmost leaf
+				for (auto &value : other) {
+					__emplace_key(__key(value), [&](Value *slot) { std::construct_at(slot, value); });
+				}
+			}
+
+			constexpr __btree(__btree &&other)
+				: _comp(std::move(other._comp)), _alloc(other._alloc), _leaf_alloc(other._leaf_alloc),
+				  _internal_alloc(other._internal_alloc) {
+				swap(other);
+			}
+#pragma endregion
+
+			constexpr ~__btree(void) {
+				__destroy(_root);
+			}
+
+#pragma region Assignment Operators and Functions
+			constexpr __btree &operator=(const __btree &other) {
+				if (this != &other) {
+					__btree copy(other);
+					swap(copy);
+				}
+				return *this;
+			}
+
+			constexpr __btree &operator=(__btree &&other) {
+				if (this != &other) {
+					clear();
+					swap(other);
+				}
+				return *this;
+			}
+#pragma endregion
+
+			[[nodiscard]] constexpr allocator_type get_allocator(void) const {
+				return _alloc;
+			}
+
+#pragma region Iterator Functions
+			[[nodiscard]] constexpr iterator begin(void) {
+				return __begin();
+			}
+
+			[[nodiscard]] constexpr const_iterator begin(void) const {
+				return __begin();
+			}
+
+			[[nodiscard]] constexpr const_iterator cbegin(void) const {
+				return __begin();
+			}
+
+			[[nodiscard]] constexpr iterator end(void) {
+				return __end();
+			}
+
+			[[nodiscard]] constexpr const_iterator end(void) const {
+				return __end();
+			}
+
+			[[nodiscard]] constexpr const_iterator cend(void) const {
+				return __end();
+			}
+
+			[[nodiscard]] constexpr reverse_iterator rbegin(void) {
+				return reverse_iterator(end());
+			}
+
+			[[nodiscard]] constexpr const_reverse_iterator rbegin(void) const {
+				return const_reverse_iterator(end());
+			}
+
+			[[nodiscard]] constexpr const_reverse_iterator crbegin(void) const {
+				return const_reverse_iterator(end());
+			}
+
+			[[nodiscard]] constexpr reverse_iterator rend(void) {
+				return reverse_iterator(begin());
+			}
+
+			[[nodiscard]] constexpr const_reverse_iterator rend(void) const {
+				return const_reverse_iterator(begin());
+			}
+
+			[[nodiscard]] constexpr const_reverse_iterator crend(void) const {
+				return const_reverse_iterator(begin());
+			}
+#pragma endregion
+
+#pragma region Capacity Functions
+			[[nodiscard]] constexpr bool empty(void) const {
+				return _size == 0;
+			}
+
+			[[nodiscard]] constexpr size_t size(void) const {
+				return _size;
+			}
+
+			[[nodiscard]] constexpr size_t max_size(void) const {
+				return INTMAX_MAX / sizeof(Value);
+			}
+#pragma endregion
+
+#pragma region Modifier Functions
+			constexpr void clear(void) {
+				__destroy(_root);
+				_root = nullptr;
+				_size = 0;
+			}
+
+			constexpr std::pair<iterator, bool> insert(const value_type &value) {
+				return __emplace_key(__key(value), [&](Value *slot) { std::construct_at(slot, value); });
+			}
+
+			constexpr std::pair<iterator, bool> insert(value_type &&value) {
+				return __emplace_key(__key(value), [&](Value *slot) { std::construct_at(slot, std::move(value)); });
+			}
+
+			constexpr iterator insert(const_iterator, const value_type &value) {
+				return insert(value).first;
+			}
+
+			constexpr iterator insert(const_iterator, value_type &&value) {
+				return insert(std::move(value)).first;
+			}
+
+			template <typename Iter>
+			constexpr void insert(Iter first, Iter last) {
+				for (; first != last; ++first) {
+					insert(*first);
+				}
+			}
+
+			constexpr void insert(std::initializer_list<value_type> list) {
+				insert(list.begin(), list.end());
+			}
+
+			template <typename... Args>
+			constexpr std::pair<iterator, bool> emplace(Args &&...args) {
+				// the key is only known once the value has been constructed
+				value_type value(std::forward<Args>(args)...);
+				return insert(std::move(value));
+			}
+
+			template <typename... Args>
+			constexpr iterator emplace_hint(const_iterator, Args &&...args) {
+				return emplace(std::forward<Args>(args)...).first;
+			}
+
+			/**
+			 * @note Values move between nodes when the tree is rebalanced, so the next value is found again by its key
+			 */
+			constexpr iterator erase(const_iterator pos) {
+				auto next = iterator(pos._node, pos._position);
+				++next;
+				if (next == __end()) {
+					__erase_at(pos._node, pos._position);
+					return __end();
+				}
+
+				Key next_key = __key(*next);
+				__erase_at(pos._node, pos._position);
+				return __lower_bound(next_key);
+			}
+
+			constexpr iterator erase(const_iterator first, const_iterator last) {
+				if (first == __begin() && last == __end()) {
+					clear();
+					return __end();
+				}
+				if (last == __end()) {
+					auto it = iterator(first._node, first._position);
+					while (it != __end()) {
+						it = erase(it);
+					}
+					return __end();
+				}
+
+				Key last_key = __key(*last);
+				auto it = iterator(first._node, first._position);
+				while (it != __end() && __less(__key(*it), last_key)) {
+					it = erase(it);
+				}
+				return it;
+			}
+
+			constexpr size_t erase(const Key &key) {
+				auto it = __find(key);
+				if (it == __end()) {
+					return 0;
+				}
+				__erase_at(it._node, it._position);
+				return 1;
+			}
+
+			constexpr void swap(__btree &other) {
+				std::swap(_root, other._root);
+				std::swap(_size, other._size);
+				std::swap(_comp, other._comp);
+			}
+#pragma endregion
+
+#pragma region Lookup Functions
+			[[nodiscard]] constexpr size_t count(const Key &key) const {
+				return contains(key) ? 1 : 0;
+			}
+
+			[[nodiscard]] constexpr iterator find(const Key &key) {
+				return __find(key);
+			}
+
+			[[nodiscard]] constexpr const_iterator find(const Key &key) const {
+				return __find(key);
+			}
+
+			[[nodiscard]] constexpr bool contains(const Key &key) const {
+				return __find(key) != __end();
+			}
+
+			[[nodiscard]] constexpr iterator lower_bound(const Key &key) {
+				return __lower_bound(key);
+			}
+
+			[[nodiscard]] constexpr const_iterator lower_bound(const Key &key) const {
+				return __lower_bound(key);
+			}
+
+			[[nodiscard]] constexpr iterator upper_bound(const Key &key) {
+				return __upper_bound(key);
+			}
+
+			[[nodiscard]] constexpr const_iterator upper_bound(const Key &key) const {
+				return __upper_bound(key);
+			}
+
+			[[nodiscard]] constexpr std::pair<iterator, iterator> equal_range(const Key &key) {
+				return {__lower_bound(key), __upper_bound(key)};
+			}
+
+			[[nodiscard]] constexpr std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+				return {__lower_bound(key), __upper_bound(key)};
+			}
+#pragma endregion
+
+#pragma region Observer Functions
+			[[nodiscard]] constexpr key_compare key_comp(void) const {
+				return _comp;
+			}
+#pragma endregion
+		};
+
+		/**
+		 * @brief Check if two B-trees hold the same values
+		 *
+		 */
+		template <typename Key, typename Value, typename KeyOf, typename Compare, typename A>
+		[[nodiscard]] constexpr bool __btree_equal(const __btree<Key, Value, KeyOf, Compare, A> &lhs,
+												   const __btree<Key, Value, KeyOf, Compare, A> &rhs) {
+			if (lhs.size() != rhs.size()) {
+				return false;
+			}
+			auto it = rhs.begin();
+			for (auto &value : lhs) {
+				if (!(value == *it)) {
+					return false;
+				}
+				++it;
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
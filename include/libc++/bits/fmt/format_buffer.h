@@ -47,6 +47,19 @@ namespace std::__detail {
 			}
 			_ptr[_size++] = value;
 		}
+
+		constexpr void append(const Char *str, size_t count) {
+			while (count > 0) {
+				if (_size >= _capacity) {
+					grow(_size + 1);
+				}
+				size_t chunk = std::min(count, _capacity - _size);
+				std::copy_n(str, chunk, _ptr + _size);
+				_size += chunk;
+				str += chunk;
+				count -= chunk;
+			}
+		}
 	};
 
 	template <typename Iter, typename Char>
@@ -56,8 +69,9 @@ namespace std::__detail {
 		Char _data[__format_buffer_size];
 		Iter _iter;
 		difference_type _max;
+		difference_type _count = 0; // characters formatted, including any past _max
 
-		explicit __format_iter_buf(Iter iter, difference_type size = __format_buffer_size)
+		explicit __format_iter_buf(Iter iter, difference_type size = __PTRDIFF_MAX__)
 			: __format_buf<Char>(_data, 0, __format_buffer_size), _iter(std::move(iter)), _max(size) {}
 
 		~__format_iter_buf() {
@@ -68,10 +82,8 @@ namespace std::__detail {
 
 		void flush(void) {
 			auto size = std::min(this->_size, static_cast<size_t>(_max));
-			// _iter = std::copy_n(this->_ptr, size, _iter); // TODO add copy_n
-			for (size_t i = 0; i < size; i++) {
-				*_iter++ = this->_ptr[i];
-			}
+			_iter = std::copy_n(this->_ptr, size, std::move(_iter));
+			_count += this->_size;
 			this->_size = 0;
 			_max -= size;
 		}
@@ -89,7 +101,7 @@ namespace std::__detail {
 		}
 
 		difference_type count(void) {
-			return this->_size;
+			return _count + this->_size;
 		}
 	};
 
@@ -0,0 +1,281 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-29
+ * @brief Format strings that are parsed at compile time
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include <array>
+#include <bits/back_insert_iterator.h>
+#include <bits/fmt/format_args.h>
+#include <bits/fmt/format_buffer.h>
+#include <bits/fmt/format_context.h>
+#include <bits/fmt/format_fwd.h>
+#include <bits/fmt/format_parse_context.h>
+#include <bits/fmt/formatter.h>
+#include <string>
+#include <utility>
+
+namespace std {
+	namespace __detail {
+		inline constexpr size_t __format_literal = static_cast<size_t>(-1);
+
+		/**
+		 * @brief A literal run or replacement field of a compiled format string
+		 */
+		struct __format_segment {
+			size_t _begin = 0; // start of the literal or the format spec
+			size_t _end = 0;   // end of the literal or the format spec
+			size_t _arg = __format_literal;
+		};
+
+		/**
+		 * @brief Split a format string into segments
+		 *
+		 * @param fmt The format string
+		 * @param segments The output segments, or nullptr to only count them
+		 * @return The number of segments
+		 */
+		template <typename Char>
+		consteval size_t __compile_format(basic_string_view<Char> fmt, __format_segment *segments) {
+			size_t count = 0;
+			size_t next_id = 0;
+			bool manual = false;
+			size_t pos = 0;
+
+			auto emit = [&](__format_segment segment) {
+				if (segments != nullptr) {
+					segments[count] = segment;
+				}
+				count++;
+			};
+
+			size_t literal = 0;
+			bool in_literal = false;
+			auto flush = [&](size_t end) {
+				if (in_literal && end != literal) {
+					emit({literal, end, __format_literal});
+				}
+				in_literal = false;
+			};
+
+			while (pos < fmt.size()) {
+				if (fmt[pos] == Char('{') || fmt[pos] == Char('}')) {
+					// escaped '{' or '}', the first brace ends the current literal
+					if (pos + 1 < fmt.size() && fmt[pos + 1] == fmt[pos]) {
+						if (!in_literal) {
+							literal = pos;
+							in_literal = true;
+						}
+						flush(pos + 1);
+						pos += 2;
+						continue;
+					}
+					if (fmt[pos] == Char('}')) {
+						std::unreachable(); // unmatched '}'
+					}
+
+					flush(pos);
+					pos++;
+
+					// get arg id
+					size_t id;
+					if (pos < fmt.size() && Char('0') <= fmt[pos] && fmt[pos] <= Char('9')) {
+						if (next_id != 0 && !manual) {
+							std::unreachable(); // mixed automatic and manual indexing
+						}
+						manual = true;
+						id = 0;
+						while (pos < fmt.size() && Char('0') <= fmt[pos] && fmt[pos] <= Char('9')) {
+							id = id * 10 + (fmt[pos] - Char('0'));
+							pos++;
+						}
+					} else {
+						if (manual) {
+							std::unreachable(); // mixed automatic and manual indexing
+						}
+						id = next_id++;
+					}
+
+					if (pos < fmt.size() && fmt[pos] == Char(':')) {
+						pos++;
+					} else if (pos >= fmt.size() || fmt[pos] != Char('}')) {
+						std::unreachable(); // invalid arg id
+					}
+
+					// the spec runs until the closing '}', nested fields are not supported
+					size_t spec = pos;
+					while (pos < fmt.size() && fmt[pos] != Char('}')) {
+						if (fmt[pos] == Char('{')) {
+							std::unreachable();
+						}
+						pos++;
+					}
+					if (pos >= fmt.size()) {
+						std::unreachable(); // missing '}'
+					}
+					emit({spec, pos, id});
+					pos++;
+					continue;
+				}
+
+				if (!in_literal) {
+					literal = pos;
+					in_literal = true;
+				}
+				pos++;
+			}
+			flush(pos);
+
+			return count;
+		}
+
+		template <typename T, typename Char>
+		consteval auto __format_map(void) {
+			using D = decay_t<T>;
+			if constexpr (is_same_v<D, Char> || is_same_v<D, bool>) {
+				return type_identity<D>{};
+			} else if constexpr (is_same_v<D, long double>) {
+				return type_identity<double>{};
+			} else if constexpr (is_arithmetic_v<D>) {
+				return type_identity<D>{};
+			} else if constexpr (is_same_v<D, Char *> || is_same_v<D, const Char *>) {
+				return type_identity<const Char *>{};
+			} else if constexpr (is_pointer_v<D> || is_same_v<D, nullptr_t>) {
+				return type_identity<const void *>{};
+			} else if constexpr (is_convertible_v<const D &, basic_string_view<Char>>) {
+				return type_identity<basic_string_view<Char>>{};
+			} else {
+				return type_identity<D>{};
+			}
+		}
+
+		/**
+		 * @brief The type an argument is formatted as, matching basic_format_arg
+		 */
+		template <typename T, typename Char>
+		using __format_mapped_t = typename decltype(__format_map<T, Char>())::type;
+
+		template <size_t I, typename T, typename... Rest>
+		constexpr const auto &__pack_get(const T &first, const Rest &...rest) {
+			if constexpr (I == 0) {
+				return first;
+			} else {
+				return __pack_get<I - 1>(rest...);
+			}
+		}
+
+		template <__fixed_string Str>
+		struct __compiled_format {
+			using Char = typename decltype(Str)::char_type;
+			using Context = basic_format_context<__format_iter<Char>, Char>;
+
+			static constexpr basic_string_view<Char> _format = Str.__view();
+			static constexpr size_t _count = __compile_format<Char>(_format, nullptr);
+			static constexpr array<__format_segment, _count> _segments = []() consteval {
+				array<__format_segment, _count> segments;
+				__compile_format<Char>(_format, segments.data());
+				return segments;
+			}();
+
+			/**
+			 * @brief Parse the spec of a replacement field into its formatter
+			 */
+			template <typename T, size_t NumArgs>
+			static consteval formatter<T, Char> __parse(__format_segment segment) {
+				formatter<T, Char> result;
+				auto spec = _format.substr(segment._begin, segment._end - segment._begin + 1);
+				basic_format_parse_context<Char> ctx(spec, NumArgs);
+				auto end = result.parse(ctx);
+				if (end != spec.begin() + (segment._end - segment._begin)) {
+					std::unreachable(); // spec not fully consumed
+				}
+				return result;
+			}
+
+			template <size_t I, typename... Args>
+			static void __format_field(__format_buf<Char> &buffer, Context &ctx, const Args &...args) {
+				constexpr __format_segment segment = _segments[I];
+				if constexpr (segment._arg == __format_literal) {
+					buffer.append(_format.data() + segment._begin, segment._end - segment._begin);
+				} else {
+					static_assert(segment._arg < sizeof...(Args), "format argument index out of range");
+					using Arg = remove_cvref_t<decltype(__pack_get<segment._arg>(args...))>;
+					using T = __format_mapped_t<Arg, Char>;
+
+					static constexpr formatter<T, Char> parsed = __parse<T, sizeof...(Args)>(segment);
+					auto fmt = parsed; // format is allowed to modify the formatter
+					ctx.advance_to(fmt.format(static_cast<const T &>(__pack_get<segment._arg>(args...)), ctx));
+				}
+			}
+
+			template <typename... Args>
+			static void format(__format_buf<Char> &buffer, const Args &...args) {
+				// custom formatters may still look up arguments through the context
+				auto store = __format_store<Context, const __format_mapped_t<Args, Char> &...>(args...);
+				Context ctx{basic_format_args<Context>(store), __format_iter<Char>(buffer)};
+
+				[&]<size_t... I>(index_sequence<I...>) {
+					(__format_field<I>(buffer, ctx, args...), ...);
+				}(make_index_sequence<_count>{});
+			}
+		};
+	}
+
+	namespace fmt {
+		/**
+		 * @brief A format string that has been split and parsed at compile time
+		 * @note This is not part of the C++ standard library
+		 *
+		 * @tparam Str The format string
+		 */
+		template <__detail::__fixed_string Str>
+		struct compiled_string {
+			using char_type = typename decltype(Str)::char_type;
+		};
+
+		/**
+		 * @brief Compile a format string, every field's spec is parsed when the
+		 * program is compiled and only the formatting itself is done at runtime
+		 * @note This is not part of the C++ standard library
+		 *
+		 * Arguments are not type erased, so each distinct set of argument types
+		 * instantiates its own code. Nested replacement fields are not supported.
+		 *
+		 * @code std::format_to(out, std::fmt::compile<"{}: {:#x}">, name, value); @endcode
+		 */
+		template <__detail::__fixed_string Str>
+		inline constexpr compiled_string<Str> compile{};
+	}
+
+	template <typename Iter, __detail::__fixed_string Str, typename... Args>
+	inline Iter format_to(Iter iter, fmt::compiled_string<Str>, const Args &...args) {
+		using Char = typename decltype(Str)::char_type;
+		__detail::__format_iter_buf<Iter, Char> buffer(std::move(iter));
+		__detail::__compiled_format<Str>::format(buffer, args...);
+		return buffer.out();
+	}
+
+	template <__detail::__fixed_string Str, typename... Args>
+	[[nodiscard]] inline basic_string<typename decltype(Str)::char_type> format(fmt::compiled_string<Str> fmt, const Args &...args) {
+		basic_string<typename decltype(Str)::char_type> str;
+		format_to(back_inserter(str), fmt, args...);
+		return str;
+	}
+
+	template <__detail::__fixed_string Str, typename... Args>
+	[[nodiscard]] size_t formatted_size(fmt::compiled_string<Str>, const Args &...args) {
+		__detail::__format_count_buf<typename decltype(Str)::char_type> buffer;
+		__detail::__compiled_format<Str>::format(buffer, args...);
+		return buffer.count();
+	}
+}
\ No newline at end of file
@@ -44,6 +44,9 @@ namespace std {
 		template <typename Ch, typename... Args>
 		friend struct basic_format_string;
 
+		template <__detail::__fixed_string Str>
+		friend struct __detail::__compiled_format;
+
 	  public:
 		constexpr basic_format_context(void) = default;
 		constexpr ~basic_format_context() = default;
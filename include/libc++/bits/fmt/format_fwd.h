@@ -50,6 +50,32 @@ namespace std {
 	using wformat_parse_context = basic_format_parse_context<wchar_t>;
 
 	namespace __detail {
+		/**
+		 * @brief A string that can be used as a template argument
+		 *
+		 * @tparam Char The character type
+		 * @tparam N The size of the string, including the null terminator
+		 */
+		template <typename Char, size_t N>
+		struct __fixed_string {
+			using char_type = Char;
+
+			Char _data[N] = {};
+
+			consteval __fixed_string(const Char (&str)[N]) {
+				for (size_t i = 0; i < N; i++) {
+					_data[i] = str[i];
+				}
+			}
+
+			[[nodiscard]] constexpr basic_string_view<Char> __view(void) const {
+				return basic_string_view<Char>(_data, N - 1);
+			}
+		};
+
+		template <__fixed_string Str>
+		struct __compiled_format;
+
 		template <typename Iter, typename Char, typename Context>
 		inline constexpr Iter __vformat_to(Iter, basic_string_view<Char>, const basic_format_args<Context> &);
 
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <bits/fmt/format_fwd.h>
+#include <charconv>
 #include <iterator> // HACK should probably just use an iterator that doesn't require this (not back_insert_iterator)
 
 namespace std {
@@ -64,7 +65,8 @@ namespace std {
 
 		template <typename Char, typename Iter>
 		constexpr Iter parse_fill(Iter begin, Iter end, Char &fill, alignment &align) {
-			if (begin == end) {
+			// an empty specification, the '}' is not a fill character
+			if (begin == end || *begin == Char('}')) {
 				return begin;
 			}
 
@@ -94,11 +96,13 @@ namespace std {
 			}
 
 			if (*begin >= Char('0') && *begin <= Char('9')) {
-				width = *begin - '0';
-				std::advance(begin, 1);
+				width = 0;
+				while (begin != end && *begin >= Char('0') && *begin <= Char('9')) {
+					width = width * 10 + (*begin - '0');
+					std::advance(begin, 1);
+				}
 				return begin;
 			}
-			// TODO parse more digits
 			// TODO parse width from argument
 
 			return begin;
@@ -112,19 +116,210 @@ namespace std {
 
 			if (*begin == Char('.')) {
 				++begin;
-				if (*begin >= Char('0') && *begin <= Char('9')) {
-					precision = *begin - '0';
-					std::advance(begin, 1);
+				if (begin != end && *begin >= Char('0') && *begin <= Char('9')) {
+					precision = 0;
+					while (begin != end && *begin >= Char('0') && *begin <= Char('9')) {
+						precision = precision * 10 + (*begin - '0');
+						std::advance(begin, 1);
+					}
 					return begin;
 				} else {
 					std::unreachable();
 				}
 			}
-			// TODO parse more digits
 			// TODO parse precision from argument
 
 			return begin;
 		}
+
+		enum class sign {
+			MINUS = 0,
+			PLUS,
+			SPACE
+		};
+
+		template <typename Char, typename Iter>
+		constexpr Iter parse_sign(Iter begin, Iter end, sign &sign) {
+			if (begin == end) {
+				return begin;
+			}
+
+			switch (*begin) {
+				case Char('+'):
+					sign = sign::PLUS;
+					break;
+				case Char('-'):
+					sign = sign::MINUS;
+					break;
+				case Char(' '):
+					sign = sign::SPACE;
+					break;
+				default:
+					return begin;
+			}
+			std::advance(begin, 1);
+			return begin;
+		}
+
+		/**
+		 * @brief The standard format specification shared by the arithmetic formatters,
+		 * [[fill]align][sign][#][0][width][.precision][type]
+		 *
+		 * @tparam Char The character type
+		 */
+		template <typename Char>
+		struct format_spec {
+			alignment _align = alignment::UNKNOWN;
+			Char _fill = Char(' ');
+			sign _sign = sign::MINUS;
+			bool _alternate = false;
+			bool _zero = false;
+			int _width = -1;
+			int _precision = -1;
+			Char _type = Char(0);
+
+			constexpr auto parse(basic_format_parse_context<Char> &ctx) {
+				auto begin = ctx.begin();
+				auto end = ctx.end();
+				begin = parse_fill(begin, end, _fill, _align);
+				begin = parse_sign<Char>(begin, end, _sign);
+				if (begin != end && *begin == Char('#')) {
+					_alternate = true;
+					std::advance(begin, 1);
+				}
+				if (begin != end && *begin == Char('0')) {
+					_zero = true;
+					std::advance(begin, 1);
+				}
+				begin = parse_width<Char>(begin, end, _width);
+				begin = parse_precision<Char>(begin, end, _precision);
+				if (begin != end && *begin != Char('}')) {
+					_type = *begin;
+					std::advance(begin, 1);
+				}
+				return begin;
+			}
+
+			/**
+			 * @brief Write converted characters, padded to the field width
+			 *
+			 * @param ctx The format context
+			 * @param first The beginning of the characters
+			 * @param last The end of the characters
+			 * @param prefix The number of leading sign and base prefix characters that zero padding goes after, or -1
+			 * if zero padding does not apply
+			 * @param align The alignment to use if none was given
+			 * @return The output iterator
+			 */
+			template <typename Iter>
+			Iter write(basic_format_context<Iter, Char> &ctx, const char *first, const char *last, int prefix,
+					   alignment align) const {
+				auto out = ctx.out();
+				int len = static_cast<int>(last - first);
+				int padding = _width > len ? _width - len : 0;
+
+				if (_zero && _align == alignment::UNKNOWN && prefix >= 0) {
+					for (int i = 0; i < prefix; i++) {
+						*out++ = Char(*first++);
+					}
+					for (int i = 0; i < padding; i++) {
+						*out++ = Char('0');
+					}
+					padding = 0;
+				}
+
+				int leading = 0;
+				switch (_align == alignment::UNKNOWN ? align : _align) {
+					case alignment::RIGHT:
+						leading = padding;
+						break;
+					case alignment::CENTER:
+						leading = padding / 2;
+						break;
+					default:
+						break;
+				}
+
+				for (int i = 0; i < leading; i++) {
+					*out++ = _fill;
+				}
+				while (first != last) {
+					*out++ = Char(*first++);
+				}
+				for (int i = leading; i < padding; i++) {
+					*out++ = _fill;
+				}
+				return out;
+			}
+
+			/**
+			 * @brief Format an integer according to the presentation type
+			 *
+			 * @param ctx The format context
+			 * @param value The integer
+			 * @return The output iterator
+			 */
+			template <typename Iter, typename T>
+			Iter write_integer(basic_format_context<Iter, Char> &ctx, T value) const {
+				// sign, a two character prefix and 64 binary digits
+				char buffer[3 + 64];
+				char *ptr = buffer;
+
+				using U = make_unsigned_t<T>;
+				U magnitude = static_cast<U>(value);
+				if (value < 0) {
+					*ptr++ = '-';
+					magnitude = U(0) - magnitude;
+				} else if (_sign == sign::PLUS) {
+					*ptr++ = '+';
+				} else if (_sign == sign::SPACE) {
+					*ptr++ = ' ';
+				}
+
+				int base = 10;
+				const char *base_prefix = "";
+				switch (_type) {
+					case Char('b'):
+						base = 2;
+						base_prefix = "0b";
+						break;
+					case Char('B'):
+						base = 2;
+						base_prefix = "0B";
+						break;
+					case Char('o'):
+						base = 8;
+						base_prefix = magnitude != 0 ? "0" : "";
+						break;
+					case Char('x'):
+						base = 16;
+						base_prefix = "0x";
+						break;
+					case Char('X'):
+						base = 16;
+						base_prefix = "0X";
+						break;
+					default:
+						break;
+				}
+				if (_alternate) {
+					while (*base_prefix) {
+						*ptr++ = *base_prefix++;
+					}
+				}
+
+				int prefix = static_cast<int>(ptr - buffer);
+				auto end = std::to_chars(ptr, buffer + sizeof(buffer), magnitude, base).ptr;
+				if (_type == Char('X')) {
+					for (; ptr != end; ptr++) {
+						if (*ptr >= 'a') {
+							*ptr -= 'a' - 'A';
+						}
+					}
+				}
+				return write(ctx, buffer, end, prefix, alignment::RIGHT);
+			}
+		};
 	}
 
 #ifdef DNDEBUG
@@ -148,59 +343,145 @@ namespace std {
 
 	template <typename Char>
 	struct formatter<Char, Char> {
+		fmt::format_spec<Char> _spec;
+
 		constexpr auto parse(basic_format_parse_context<Char> &ctx) {
-			return ctx.begin();
+			return _spec.parse(ctx);
 		}
 
 		template <typename Iter>
 		Iter format(const Char value, basic_format_context<Iter, Char> &ctx) {
-			(void)value;
-			*ctx.out()++ = Char('c');
-			return ctx.out();
+			if (_spec._type != Char(0) && _spec._type != Char('c')) {
+				return _spec.write_integer(ctx, static_cast<make_unsigned_t<Char>>(value));
+			}
+
+			// TODO support characters that do not fit in a char
+			char ch = static_cast<char>(value);
+			return _spec.write(ctx, &ch, &ch + 1, -1, fmt::alignment::LEFT);
 		}
 	};
 
 	template <typename Char>
 	struct formatter<bool, Char> {
+		fmt::format_spec<Char> _spec;
+
 		constexpr auto parse(basic_format_parse_context<Char> &ctx) {
-			return ctx.begin();
+			return _spec.parse(ctx);
 		}
 
 		template <typename Iter>
 		Iter format(const bool value, basic_format_context<Iter, Char> &ctx) {
-			(void)value;
-			*ctx.out()++ = Char('b');
-			return ctx.out();
+			if (_spec._type != Char(0) && _spec._type != Char('s')) {
+				return _spec.write_integer(ctx, static_cast<unsigned>(value));
+			}
+
+			const char *str = value ? "true" : "false";
+			return _spec.write(ctx, str, str + (value ? 4 : 5), -1, fmt::alignment::LEFT);
 		}
 	};
 
 	template <typename T, typename Char>
 		requires std::is_integral_v<T>
 	struct formatter<T, Char> {
+		fmt::format_spec<Char> _spec;
+
 		constexpr auto parse(basic_format_parse_context<Char> &ctx) {
-			return ctx.begin();
+			return _spec.parse(ctx);
 		}
 
 		template <typename Iter>
 		Iter format(const T value, basic_format_context<Iter, Char> &ctx) {
-			(void)value;
-			*ctx.out()++ = Char('i');
-			return ctx.out();
+			if (_spec._type == Char('c')) {
+				char ch = static_cast<char>(value);
+				return _spec.write(ctx, &ch, &ch + 1, -1, fmt::alignment::LEFT);
+			}
+			return _spec.write_integer(ctx, value);
 		}
 	};
 
 	template <typename T, typename Char>
 		requires std::is_floating_point_v<T>
 	struct formatter<T, Char> {
+		fmt::format_spec<Char> _spec;
+
 		constexpr auto parse(basic_format_parse_context<Char> &ctx) {
-			return ctx.begin();
+			return _spec.parse(ctx);
 		}
 
 		template <typename Iter>
 		Iter format(const T value, basic_format_context<Iter, Char> &ctx) {
-			(void)value;
-			*ctx.out()++ = Char('f');
-			return ctx.out();
+			// large enough for the longest fixed notation double with the largest precision
+			constexpr int MAX_PRECISION = 180;
+			char buffer[512];
+			char *ptr = buffer;
+
+			// TODO long double
+			auto number = static_cast<conditional_t<is_same_v<T, float>, float, double>>(value);
+			if (!__builtin_signbit(number)) {
+				if (_spec._sign == fmt::sign::PLUS) {
+					*ptr++ = '+';
+				} else if (_spec._sign == fmt::sign::SPACE) {
+					*ptr++ = ' ';
+				}
+			}
+
+			int precision = _spec._precision < MAX_PRECISION ? _spec._precision : MAX_PRECISION;
+			chars_format format = chars_format::general;
+			bool uppercase = false;
+			switch (_spec._type) {
+				case Char('E'):
+					uppercase = true;
+					[[fallthrough]];
+				case Char('e'):
+					format = chars_format::scientific;
+					precision = precision < 0 ? 6 : precision;
+					break;
+				case Char('F'):
+					uppercase = true;
+					[[fallthrough]];
+				case Char('f'):
+					format = chars_format::fixed;
+					precision = precision < 0 ? 6 : precision;
+					break;
+				case Char('G'):
+					uppercase = true;
+					[[fallthrough]];
+				case Char('g'):
+					precision = precision < 0 ? 6 : precision;
+					break;
+				case Char('A'):
+					uppercase = true;
+					[[fallthrough]];
+				case Char('a'):
+					format = chars_format::hex;
+					break;
+				default:
+					break;
+			}
+
+			// TODO alternate form (#)
+			to_chars_result result;
+			if (precision >= 0) {
+				result = std::to_chars(ptr, buffer + sizeof(buffer), number, format, precision);
+			} else if (_spec._type == Char(0)) {
+				result = std::to_chars(ptr, buffer + sizeof(buffer), number);
+			} else {
+				result = std::to_chars(ptr, buffer + sizeof(buffer), number, format);
+			}
+
+			char *digits = *ptr == '-' ? ptr + 1 : ptr;
+			bool finite = *digits >= '0' && *digits <= '9';
+			if (uppercase) {
+				for (auto it = digits; it != result.ptr; it++) {
+					if (*it >= 'a' && *it <= 'z') {
+						*it -= 'a' - 'A';
+					}
+				}
+			}
+
+			// zero padding does not apply to infinity and NaN
+			return _spec.write(ctx, buffer, result.ptr, finite ? static_cast<int>(digits - buffer) : -1,
+							   fmt::alignment::RIGHT);
 		}
 	};
 
@@ -268,16 +549,18 @@ namespace std {
 
 	template <typename Char>
 	struct formatter<const void *, Char> {
+		fmt::format_spec<Char> _spec;
+
 		constexpr auto parse(basic_format_parse_context<Char> &ctx) {
-			return ctx.begin();
+			return _spec.parse(ctx);
 		}
 
 		template <typename Iter>
 		Iter format(const void *value, basic_format_context<Iter, Char> &ctx) {
-			(void)value;
-			*ctx.out()++ = Char('p');
-			return ctx.out();
+			char buffer[2 + 16] = {'0', 'x'};
+			auto end = std::to_chars(buffer + 2, buffer + sizeof(buffer), reinterpret_cast<uintptr_t>(value), 16).ptr;
+			return _spec.write(ctx, buffer, end, 2, fmt::alignment::RIGHT);
 		}
 	};
 
-}
+}
\ No newline at end of file
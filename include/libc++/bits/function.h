@@ -0,0 +1,406 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-26
+ * @brief Type-erased wrapper for copyable callable objects
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include <bits/construct.h>
+#include <bits/invoke.h>
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace std {
+	namespace __detail {
+		// large enough for a lambda capturing three pointers (or references)
+		inline constexpr size_t __function_buffer_size = 3 * sizeof(void *);
+
+		/**
+		 * @brief Storage for a type-erased callable, either inline or on the heap
+		 *
+		 */
+		union __function_storage {
+			void *_heap;
+			alignas(void *) unsigned char _buffer[__function_buffer_size];
+		};
+
+		/**
+		 * @brief Check if a callable is stored inline rather than on the heap
+		 *
+		 * @tparam F The type of the callable
+		 */
+		template <typename F>
+		inline constexpr bool __function_is_small = sizeof(F) <= __function_buffer_size &&
+													alignof(F) <= alignof(void *) &&
+													is_nothrow_move_constructible_v<F>;
+
+		/**
+		 * @brief Get the callable held by some storage
+		 *
+		 * @tparam F The type of the callable
+		 * @param storage The storage holding the callable
+		 * @return A pointer to the callable
+		 */
+		template <typename F>
+		[[nodiscard]] inline F *__function_target(const __function_storage &storage) {
+			if constexpr (__function_is_small<F>) {
+				auto buffer = const_cast<unsigned char *>(storage._buffer);
+				return std::launder(reinterpret_cast<F *>(buffer));
+			} else {
+				return static_cast<F *>(storage._heap);
+			}
+		}
+
+		/**
+		 * @brief Construct a callable in some storage
+		 *
+		 * @tparam F The type of the callable
+		 * @tparam Args The types of the arguments to construct the callable with
+		 * @param storage The storage to construct the callable in
+		 * @param args The arguments to construct the callable with
+		 */
+		template <typename F, typename... Args>
+		inline void __function_emplace(__function_storage &storage, Args &&...args) {
+			if constexpr (__function_is_small<F>) {
+				std::construct_at(reinterpret_cast<F *>(storage._buffer), std::forward<Args>(args)...);
+			} else {
+				storage._heap = new F(std::forward<Args>(args)...);
+				assert(storage._heap);
+			}
+		}
+
+		/**
+		 * @brief The operations on a type-erased callable, one instance is shared by every wrapper of the same type
+		 *
+		 * @tparam R The return type
+		 * @tparam Args The types of the arguments
+		 */
+		template <typename R, typename... Args>
+		struct __function_vtable {
+			R (*_invoke)(const __function_storage &, Args &&...);
+			void (*_move)(__function_storage &, __function_storage &); // moves from and then destroys the source
+			void (*_copy)(__function_storage &, const __function_storage &); // nullptr if the callable is move only
+			void (*_destroy)(__function_storage &);
+		};
+
+		/**
+		 * @brief Implementations of the vtable operations for a callable type
+		 *
+		 * @tparam F The type of the callable
+		 */
+		template <typename F>
+		struct __function_manager {
+			template <bool Const, typename R, typename... Args>
+			static R __invoke(const __function_storage &storage, Args &&...args) {
+				using Target = conditional_t<Const, const F, F>;
+				Target &func = *__function_target<F>(storage);
+				if constexpr (is_void_v<R>) {
+					std::invoke(func, std::forward<Args>(args)...);
+				} else {
+					return std::invoke(func, std::forward<Args>(args)...);
+				}
+			}
+
+			static void __move(__function_storage &dest, __function_storage &src) {
+				if constexpr (__function_is_small<F>) {
+					auto func = __function_target<F>(src);
+					std::construct_at(reinterpret_cast<F *>(dest._buffer), std::move(*func));
+					std::destroy_at(func);
+				} else {
+					dest._heap = src._heap;
+				}
+			}
+
+			static void __copy(__function_storage &dest, const __function_storage &src) {
+				if constexpr (is_copy_constructible_v<F>) {
+					__function_emplace<F>(dest, *__function_target<F>(src));
+				} else {
+					__builtin_unreachable();
+				}
+			}
+
+			static void __destroy(__function_storage &storage) {
+				if constexpr (__function_is_small<F>) {
+					std::destroy_at(__function_target<F>(storage));
+				} else {
+					delete __function_target<F>(storage);
+				}
+			}
+		};
+
+		/**
+		 * @brief The vtable for a callable type
+		 *
+		 * @tparam F The type of the callable
+		 * @tparam Copyable Whether the wrapper can be copied
+		 * @tparam Const Whether the callable is invoked as const
+		 * @tparam R The return type
+		 * @tparam Args The types of the arguments
+		 */
+		template <typename F, bool Copyable, bool Const, typename R, typename... Args>
+		inline constexpr __function_vtable<R, Args...> __function_vtable_for = {
+			&__function_manager<F>::template __invoke<Const, R, Args...>,
+			&__function_manager<F>::__move,
+			Copyable ? &__function_manager<F>::__copy : nullptr,
+			&__function_manager<F>::__destroy,
+		};
+
+		/**
+		 * @brief Check if a callable is a null function or member pointer
+		 *
+		 * @tparam F The type of the callable
+		 * @param func The callable
+		 * @return true if the callable is null, false otherwise
+		 */
+		template <typename F>
+		[[nodiscard]] constexpr bool __function_is_null(const F &func) {
+			if constexpr (is_pointer_v<F> || is_member_pointer_v<F>) {
+				return func == nullptr;
+			} else {
+				return false;
+			}
+		}
+	}
+
+	template <typename>
+	class function;
+
+	/**
+	 * @brief Type-erased wrapper for any copyable callable object
+	 *
+	 * @tparam R The return type
+	 * @tparam Args The types of the arguments
+	 *
+	 * @details Callables of up to three pointers in size are stored inline, larger ones are allocated on the heap
+	 *
+	 * @link https://en.cppreference.com/w/cpp/utility/functional/function @endlink
+	 */
+	template <typename R, typename... Args>
+	class function<R(Args...)> {
+	  public:
+		using result_type = R;
+
+	  private:
+		using vtable = __detail::__function_vtable<R, Args...>;
+
+		__detail::__function_storage _storage;
+		const vtable *_vtable = nullptr;
+
+		void __reset(void) {
+			if (_vtable) {
+				_vtable->_destroy(_storage);
+				_vtable = nullptr;
+			}
+		}
+
+	  public:
+#pragma region Constructors
+		/**
+		 * @brief Construct a new empty function object
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/function @endlink
+		 */
+		function(void) noexcept = default;
+
+		/**
+		 * @brief Construct a new empty function object
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/function @endlink
+		 */
+		function(nullptr_t) noexcept {}
+
+		/**
+		 * @brief Construct a new function object
+		 *
+		 * @param other The function to copy
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/function @endlink
+		 */
+		function(const function &other) {
+			if (other._vtable) {
+				other._vtable->_copy(_storage, other._storage);
+				_vtable = other._vtable;
+			}
+		}
+
+		/**
+		 * @brief Construct a new function object
+		 *
+		 * @param other The function to move
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/function @endlink
+		 */
+		function(function &&other) noexcept {
+			if (other._vtable) {
+				other._vtable->_move(_storage, other._storage);
+				_vtable = other._vtable;
+				other._vtable = nullptr;
+			}
+		}
+
+		/**
+		 * @brief Construct a new function object
+		 *
+		 * @tparam F The type of the callable
+		 * @param func The callable to wrap
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/function @endlink
+		 */
+		template <typename F>
+			requires(!is_same_v<remove_cvref_t<F>, function> && is_copy_constructible_v<decay_t<F>> &&
+					 is_invocable_r_v<R, decay_t<F> &, Args...>)
+		function(F &&func) {
+			using D = decay_t<F>;
+			if (__detail::__function_is_null(func)) {
+				return;
+			}
+			__detail::__function_emplace<D>(_storage, std::forward<F>(func));
+			_vtable = &__detail::__function_vtable_for<D, true, false, R, Args...>;
+		}
+#pragma endregion
+
+#pragma region Assignment Operators
+		/**
+		 * @brief Copies the callable of the given function
+		 *
+		 * @param other The function to copy
+		 * @return A reference to this function
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/operator%3D @endlink
+		 */
+		function &operator=(const function &other) {
+			function(other).swap(*this);
+			return *this;
+		}
+
+		/**
+		 * @brief Moves the callable of the given function
+		 *
+		 * @param other The function to move
+		 * @return A reference to this function
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/operator%3D @endlink
+		 */
+		function &operator=(function &&other) noexcept {
+			if (this != &other) {
+				__reset();
+				if (other._vtable) {
+					other._vtable->_move(_storage, other._storage);
+					_vtable = other._vtable;
+					other._vtable = nullptr;
+				}
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Destroys the wrapped callable
+		 *
+		 * @return A reference to this function
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/operator%3D @endlink
+		 */
+		function &operator=(nullptr_t) noexcept {
+			__reset();
+			return *this;
+		}
+
+		/**
+		 * @brief Replaces the wrapped callable
+		 *
+		 * @tparam F The type of the callable
+		 * @param func The callable to wrap
+		 * @return A reference to this function
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/operator%3D @endlink
+		 */
+		template <typename F>
+			requires(!is_same_v<remove_cvref_t<F>, function> && is_copy_constructible_v<decay_t<F>> &&
+					 is_invocable_r_v<R, decay_t<F> &, Args...>)
+		function &operator=(F &&func) {
+			function(std::forward<F>(func)).swap(*this);
+			return *this;
+		}
+#pragma endregion
+
+		/**
+		 * @brief Destroy the function object
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/~function @endlink
+		 */
+		~function(void) {
+			__reset();
+		}
+
+		/**
+		 * @brief Swaps the callables of two functions
+		 *
+		 * @param other The function to swap with
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/swap @endlink
+		 */
+		void swap(function &other) noexcept {
+			function temp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temp);
+		}
+
+		/**
+		 * @brief Check if the function wraps a callable
+		 *
+		 * @return true if the function wraps a callable, false otherwise
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/operator_bool @endlink
+		 */
+		[[nodiscard]] explicit operator bool(void) const noexcept {
+			return _vtable != nullptr;
+		}
+
+		/**
+		 * @brief Invokes the wrapped callable
+		 *
+		 * @param args The arguments to pass to the callable
+		 * @return The result of the callable
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/function/operator() @endlink
+		 */
+		R operator()(Args... args) const {
+			assert(_vtable);
+			return _vtable->_invoke(_storage, std::forward<Args>(args)...);
+		}
+
+		// TODO target_type (requires RTTI)
+		// TODO target (requires RTTI)
+	};
+
+	/**
+	 * @brief Check if a function is empty
+	 *
+	 * @link https://en.cppreference.com/w/cpp/utility/functional/function/operator_cmp @endlink
+	 */
+	template <typename R, typename... Args>
+	[[nodiscard]] bool operator==(const function<R(Args...)> &func, nullptr_t) noexcept {
+		return !func;
+	}
+
+	/**
+	 * @brief Swaps the callables of two functions
+	 *
+	 * @link https://en.cppreference.com/w/cpp/utility/functional/function/swap2 @endlink
+	 */
+	template <typename R, typename... Args>
+	void swap(function<R(Args...)> &lhs, function<R(Args...)> &rhs) noexcept {
+		lhs.swap(rhs);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-19
+ * @brief Hash function objects
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace std {
+	namespace __detail {
+		/**
+		 * @brief Multiply two numbers and fold the high half of the 128-bit product into the low half
+		 *
+		 * @param a The first number
+		 * @param b The second number
+		 * @return The folded product
+		 */
+		constexpr uint64_t __hash_mix(uint64_t a, uint64_t b) {
+			auto product = static_cast<unsigned __int128>(a) * b;
+			return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+		}
+
+		/**
+		 * @brief Read up to 8 bytes as a little-endian number
+		 *
+		 * @param ptr The bytes to read
+		 * @param n The number of bytes to read
+		 * @return The number
+		 */
+		constexpr uint64_t __hash_read(const unsigned char *ptr, size_t n) {
+			uint64_t value = 0;
+			for (size_t i = 0; i < n; i++) {
+				value |= static_cast<uint64_t>(ptr[i]) << (i * 8);
+			}
+			return value;
+		}
+
+		/**
+		 * @brief Hash a sequence of bytes, eight at a time
+		 *
+		 * @param data The bytes to hash
+		 * @param n The number of bytes
+		 * @return The hash
+		 */
+		constexpr size_t __hash_bytes(const void *data, size_t n) {
+			constexpr uint64_t k0 = 0xa0761d6478bd642f;
+			constexpr uint64_t k1 = 0xe7037ed1a0b428db;
+
+			auto ptr = static_cast<const unsigned char *>(data);
+			uint64_t state = k0 ^ n;
+			while (n > 8) {
+				uint64_t word;
+				__builtin_memcpy(&word, ptr, sizeof(word));
+				state = __hash_mix(state ^ word, k1);
+				ptr += 8;
+				n -= 8;
+			}
+			return __hash_mix(state ^ __hash_read(ptr, n), k1);
+		}
+
+		/**
+		 * @brief Hash a string of characters
+		 *
+		 * @tparam T The type of the characters
+		 * @param str The string to hash
+		 * @param n The number of characters
+		 * @return The hash
+		 */
+		template <typename T>
+		constexpr size_t __hash_string(const T *str, size_t n) {
+			if (std::is_constant_evaluated()) {
+				// memcpy cannot be constant evaluated, so build the same little-endian words from the characters
+				constexpr uint64_t k0 = 0xa0761d6478bd642f;
+				constexpr uint64_t k1 = 0xe7037ed1a0b428db;
+
+				auto byte = [str](size_t i) {
+					auto c = static_cast<make_unsigned_t<T>>(str[i / sizeof(T)]);
+					return static_cast<uint64_t>(static_cast<unsigned char>(c >> (i % sizeof(T) * 8)));
+				};
+				auto read = [&byte](size_t pos, size_t count) {
+					uint64_t value = 0;
+					for (size_t i = 0; i < count; i++) {
+						value |= byte(pos + i) << (i * 8);
+					}
+					return value;
+				};
+
+				size_t bytes = n * sizeof(T);
+				uint64_t state = k0 ^ bytes;
+				size_t pos = 0;
+				while (bytes - pos > 8) {
+					state = __hash_mix(state ^ read(pos, 8), k1);
+					pos += 8;
+				}
+				return __hash_mix(state ^ read(pos, bytes - pos), k1);
+			}
+			return __hash_bytes(str, n * sizeof(T));
+		}
+	}
+
+	/**
+	 * @brief Function object that computes the hash of a value
+	 *
+	 * @tparam T The type of the value
+	 *
+	 * @note Only specializations are defined, the primary template is disabled
+	 *
+	 * @link https://en.cppreference.com/w/cpp/utility/hash @endlink
+	 */
+	template <typename T>
+	struct hash {
+		hash(void) = delete;
+		hash(const hash &) = delete;
+	};
+
+	/**
+	 * @brief Hash specialization for integral and enumeration types
+	 *
+	 * @note Integers hash to themselves, the hash containers mix the hash before use
+	 */
+	template <typename T>
+		requires(std::is_integral_v<T> || std::is_enum_v<T>)
+	struct hash<T> {
+		[[nodiscard]] constexpr size_t operator()(T value) const {
+			return static_cast<size_t>(value);
+		}
+	};
+
+	/**
+	 * @brief Hash specialization for floating point types
+	 *
+	 */
+	template <typename T>
+		requires(std::is_floating_point_v<T>)
+	struct hash<T> {
+		[[nodiscard]] size_t operator()(T value) const {
+			// 0.0 and -0.0 compare equal, so must hash equal
+			if (value == 0) {
+				return 0;
+			}
+			// only the low 10 bytes of an x87 long double hold its value, the rest is padding
+			constexpr size_t size = std::is_same_v<T, long double> ? 10 : sizeof(T);
+			return __detail::__hash_bytes(&value, size);
+		}
+	};
+
+	/**
+	 * @brief Hash specialization for pointers
+	 *
+	 */
+	template <typename T>
+	struct hash<T *> {
+		[[nodiscard]] size_t operator()(T *ptr) const {
+			return reinterpret_cast<size_t>(ptr);
+		}
+	};
+
+	/**
+	 * @brief Hash specialization for nullptr_t
+	 *
+	 */
+	template <>
+	struct hash<std::nullptr_t> {
+		[[nodiscard]] constexpr size_t operator()(std::nullptr_t) const {
+			return 0;
+		}
+	};
+}
\ No newline at end of file
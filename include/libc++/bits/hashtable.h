@@ -0,0 +1,810 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-19
+ * @brief Open addressing hash table used by the unordered containers
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#include <bits/allocator.h>
+#include <bits/allocator_traits.h>
+#include <bits/construct.h>
+#include <bits/hash.h>
+#include <bits/iterator_traits.h>
+#include <bits/key_extract.h>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <pair>
+#include <utility>
+
+namespace std {
+	namespace __detail {
+		/**
+		 * @brief A control byte, describes the state of the slot at the same index
+		 *
+		 * @details Full slots store the low 7 bits of the hash (H2) so most probes can be rejected without comparing keys.
+		 * The byte after the last slot is a sentinel that stops iteration, and it is followed by copies of the first
+		 * (width - 1) control bytes so that a group can be loaded from any slot without wrapping around.
+		 */
+		using __ctrl_t = signed char;
+
+		constexpr __ctrl_t __ctrl_empty = -128;
+		constexpr __ctrl_t __ctrl_deleted = -2;
+		constexpr __ctrl_t __ctrl_sentinel = -1;
+
+		/**
+		 * @brief A set of matching slots within a group, one bit (or byte) per slot
+		 *
+		 * @tparam Width The number of slots in a group
+		 * @tparam Shift log2 of the number of mask bits per slot
+		 */
+		template <size_t Width, int Shift>
+		struct __bitmask {
+			uint64_t _mask;
+
+			[[nodiscard]] constexpr explicit operator bool(void) const {
+				return _mask != 0;
+			}
+
+			/**
+			 * @brief Get the index of the first match, the mask must not be empty
+			 *
+			 */
+			[[nodiscard]] constexpr size_t lowest(void) const {
+				return static_cast<size_t>(__builtin_ctzll(_mask)) >> Shift;
+			}
+
+			/**
+			 * @brief Get the number of non-matching slots before the first match
+			 *
+			 */
+			[[nodiscard]] constexpr size_t trailing_zeros(void) const {
+				return _mask ? lowest() : Width;
+			}
+
+			/**
+			 * @brief Get the number of non-matching slots after the last match
+			 *
+			 */
+			[[nodiscard]] constexpr size_t leading_zeros(void) const {
+				if (_mask == 0) {
+					return Width;
+				}
+				auto unused_bits = 64 - (Width << Shift);
+				return static_cast<size_t>(__builtin_clzll(_mask) - unused_bits) >> Shift;
+			}
+
+			constexpr __bitmask &operator++(void) {
+				_mask &= _mask - 1;
+				return *this;
+			}
+		};
+
+#ifdef __SSE2__
+		typedef char __ctrl_vec __attribute__((vector_size(16), may_alias, aligned(1)));
+
+		/**
+		 * @brief A group of 16 control bytes, probed at once with SSE2
+		 *
+		 */
+		struct __group {
+			static constexpr size_t width = 16;
+			using bitmask = __bitmask<width, 0>;
+
+			__ctrl_vec _ctrl;
+
+			explicit __group(const __ctrl_t *ctrl) : _ctrl(*reinterpret_cast<const __ctrl_vec *>(ctrl)) {}
+
+			[[nodiscard]] bitmask match(__ctrl_t h2) const {
+				return {static_cast<uint32_t>(__builtin_ia32_pmovmskb128(_ctrl == static_cast<char>(h2)))};
+			}
+
+			[[nodiscard]] bitmask match_empty(void) const {
+				return match(__ctrl_empty);
+			}
+
+			[[nodiscard]] bitmask match_empty_or_deleted(void) const {
+				return {static_cast<uint32_t>(__builtin_ia32_pmovmskb128(_ctrl < static_cast<char>(__ctrl_sentinel)))};
+			}
+
+			[[nodiscard]] size_t count_leading_empty_or_deleted(void) const {
+				return static_cast<size_t>(__builtin_ctz(match_empty_or_deleted()._mask + 1));
+			}
+		};
+#else
+		/**
+		 * @brief A group of 8 control bytes, probed at once with bit tricks on a 64-bit word
+		 *
+		 */
+		struct __group {
+			static constexpr size_t width = 8;
+			using bitmask = __bitmask<width, 3>;
+
+			static constexpr uint64_t lsbs = 0x0101010101010101;
+			static constexpr uint64_t msbs = 0x8080808080808080;
+
+			uint64_t _ctrl;
+
+			explicit __group(const __ctrl_t *ctrl) {
+				__builtin_memcpy(&_ctrl, ctrl, sizeof(_ctrl));
+			}
+
+			/**
+			 * @note May report false positives in the byte after a true match, the keys are compared anyway
+			 */
+			[[nodiscard]] bitmask match(__ctrl_t h2) const {
+				auto x = _ctrl ^ (lsbs * static_cast<uint8_t>(h2));
+				return {(x - lsbs) & ~x & msbs};
+			}
+
+			[[nodiscard]] bitmask match_empty(void) const {
+				// only the empty byte has the high bit set and bit 1 clear
+				return {_ctrl & ~(_ctrl << 6) & msbs};
+			}
+
+			[[nodiscard]] bitmask match_empty_or_deleted(void) const {
+				// only the sentinel has the high bit and bit 0 set
+				return {_ctrl & ~(_ctrl << 7) & msbs};
+			}
+
+			[[nodiscard]] size_t count_leading_empty_or_deleted(void) const {
+				return bitmask{~match_empty_or_deleted()._mask & msbs}.trailing_zeros();
+			}
+		};
+#endif
+
+		template <typename Value, bool Const>
+		struct __hashtable_iterator {
+			using value_type = Value;
+			using pointer = std::conditional_t<Const, const Value *, Value *>;
+			using reference = std::conditional_t<Const, const Value &, Value &>;
+			using difference_type = ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			const __ctrl_t *_ctrl;
+			Value *_slot;
+
+			constexpr __hashtable_iterator(void) = default;
+
+			constexpr __hashtable_iterator(const __ctrl_t *ctrl, Value *slot) : _ctrl(ctrl), _slot(slot) {}
+
+			// a template, so that it does not replace the copy constructor of the mutable iterator
+			template <bool C = Const>
+				requires(C)
+			constexpr __hashtable_iterator(const __hashtable_iterator<Value, false> &other)
+				: _ctrl(other._ctrl), _slot(other._slot) {}
+
+			/**
+			 * @brief Advance to the next full slot, or to the sentinel
+			 *
+			 */
+			void __skip_empty(void) {
+				while (*_ctrl < __ctrl_sentinel) {
+					auto count = __group(_ctrl).count_leading_empty_or_deleted();
+					_ctrl += count;
+					_slot += count;
+				}
+			}
+
+			[[nodiscard]] constexpr reference operator*(void) const {
+				return *_slot;
+			}
+
+			[[nodiscard]] constexpr pointer operator->(void) const {
+				return _slot;
+			}
+
+			__hashtable_iterator &operator++(void) {
+				_ctrl++;
+				_slot++;
+				__skip_empty();
+				return *this;
+			}
+
+			__hashtable_iterator operator++(int) {
+				auto tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			[[nodiscard]] constexpr friend bool operator==(const __hashtable_iterator &lhs,
+														   const __hashtable_iterator &rhs) {
+				return lhs._ctrl == rhs._ctrl;
+			}
+		};
+
+		/**
+		 * @brief Open addressing hash table with SwissTable-style control bytes
+		 *
+		 * @details Slots are probed a group at a time: the control bytes of a whole group are compared against the H2 of
+		 * the key at once, so a lookup usually touches one group of control bytes and one slot. Groups are probed
+		 * quadratically until a group with an empty slot is found. Erased slots become tombstones unless no probe
+		 * sequence can have passed through them.
+		 *
+		 * @tparam Key The type of the keys
+		 * @tparam Value The type of the stored values
+		 * @tparam KeyOf Function object that gets the key of a value
+		 * @tparam Hash The hash function object
+		 * @tparam KeyEqual The key equality function object
+		 * @tparam A The allocator type
+		 */
+		template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename A>
+		class __hashtable {
+		  public:
+			using key_type = Key;
+			using value_type = Value;
+			using size_type = size_t;
+			using difference_type = ptrdiff_t;
+			using hasher = Hash;
+			using key_equal = KeyEqual;
+			using allocator_type = A;
+			using reference = value_type &;
+			using const_reference = const value_type &;
+			using pointer = std::allocator_traits<A>::pointer;
+			using const_pointer = std::allocator_traits<A>::const_pointer;
+			// the values of sets are their keys, so they can never be modified through an iterator
+			using iterator = __hashtable_iterator<Value, std::is_same_v<Key, Value>>;
+			using const_iterator = __hashtable_iterator<Value, true>;
+
+		  protected:
+			using ctrl_alloc_t = typename std::allocator_traits<A>::rebind_alloc<__ctrl_t>;
+			using slot_alloc_t = typename std::allocator_traits<A>::rebind_alloc<Value>;
+
+			static constexpr size_t __width = __group::width;
+
+			// always 2^n - 1, so it can be used as a mask
+			size_t _capacity = 0;
+			size_t _size = 0;
+			size_t _growth_left = 0;
+			__ctrl_t *_ctrl = nullptr;
+			Value *_slots = nullptr;
+			[[no_unique_address]] Hash _hash;
+			[[no_unique_address]] KeyEqual _equal;
+			[[no_unique_address]] slot_alloc_t _slot_alloc;
+			[[no_unique_address]] ctrl_alloc_t _ctrl_alloc;
+
+			/**
+			 * @brief Get the maximum number of elements a table can hold before it must grow, i.e. 7/8 of its capacity
+			 *
+			 */
+			[[nodiscard]] static constexpr size_t __max_growth(size_t capacity) {
+				return capacity - (capacity + 1) / 8;
+			}
+
+			/**
+			 * @brief Get the smallest valid capacity that can hold the given number of elements
+			 *
+			 */
+			[[nodiscard]] static constexpr size_t __capacity_for(size_t count) {
+				size_t capacity = __width - 1;
+				while (__max_growth(capacity) < count) {
+					capacity = capacity * 2 + 1;
+				}
+				return capacity;
+			}
+
+			/**
+			 * @brief Mix the output of the hash function so that both H1 and H2 depend on every bit of it
+			 *
+			 */
+			[[nodiscard]] constexpr size_t __hash_of(const Key &key) const {
+				return __hash_mix(std::invoke(_hash, key), 0x9e3779b97f4a7c15);
+			}
+
+			[[nodiscard]] static constexpr size_t __h1(size_t hash) {
+				return hash >> 7;
+			}
+
+			[[nodiscard]] static constexpr __ctrl_t __h2(size_t hash) {
+				return static_cast<__ctrl_t>(hash & 0x7f);
+			}
+
+			/**
+			 * @brief Set a control byte and its clone after the sentinel, if it has one
+			 *
+			 */
+			constexpr void __set_ctrl(size_t index, __ctrl_t value) {
+				_ctrl[index] = value;
+				_ctrl[((index - (__width - 1)) & _capacity) + (__width - 1)] = value;
+			}
+
+			/**
+			 * @brief Find the first empty or deleted slot in the probe sequence of a hash
+			 *
+			 */
+			[[nodiscard]] size_t __find_non_full(size_t hash) const {
+				auto offset = __h1(hash) & _capacity;
+				for (size_t step = __width;; step += __width) {
+					auto mask = __group(_ctrl + offset).match_empty_or_deleted();
+					if (mask) {
+						return (offset + mask.lowest()) & _capacity;
+					}
+					offset = (offset + step) & _capacity;
+				}
+			}
+
+			/**
+			 * @brief Find the slot holding a key
+			 *
+			 * @return The index of the slot, or the capacity if the key is not in the table
+			 */
+			[[nodiscard]] size_t __find_index(const Key &key, size_t hash) const {
+				if (_size == 0) {
+					return _capacity;
+				}
+
+				auto h2 = __h2(hash);
+				auto offset = __h1(hash) & _capacity;
+				for (size_t step = __width;; step += __width) {
+					__group group(_ctrl + offset);
+					for (auto mask = group.match(h2); mask; ++mask) {
+						auto index = (offset + mask.lowest()) & _capacity;
+						if (std::invoke(_equal, key, KeyOf()(_slots[index]))) {
+							return index;
+						}
+					}
+					if (group.match_empty()) {
+						return _capacity;
+					}
+					offset = (offset + step) & _capacity;
+				}
+			}
+
+			/**
+			 * @brief Allocate empty storage for the given capacity
+			 *
+			 */
+			void __allocate(size_t capacity) {
+				_capacity = capacity;
+				_ctrl = _ctrl_alloc.allocate(capacity + __width);
+				_slots = _slot_alloc.allocate(capacity);
+				assert(_ctrl && _slots);
+				memset(_ctrl, __ctrl_empty, capacity + __width);
+				_ctrl[capacity] = __ctrl_sentinel;
+				_growth_left = __max_growth(capacity) - _size;
+			}
+
+			/**
+			 * @brief Destroy every element and free the storage
+			 *
+			 */
+			void __destroy(void) {
+				if (_capacity == 0) {
+					return;
+				}
+				for (size_t i = 0; i < _capacity; i++) {
+					if (_ctrl[i] >= 0) {
+						std::destroy_at(&_slots[i]);
+					}
+				}
+				_ctrl_alloc.deallocate(_ctrl, _capacity + __width);
+				_slot_alloc.deallocate(_slots, _capacity);
+			}
+
+			/**
+			 * @brief Move every element into new storage of the given capacity, dropping all tombstones
+			 *
+			 */
+			void __resize(size_t capacity) {
+				auto old_ctrl = _ctrl;
+				auto old_slots = _slots;
+				auto old_capacity = _capacity;
+
+				__allocate(capacity);
+				for (size_t i = 0; i < old_capacity; i++) {
+					if (old_ctrl[i] >= 0) {
+						auto hash = __hash_of(KeyOf()(old_slots[i]));
+						auto index = __find_non_full(hash);
+						__set_ctrl(index, __h2(hash));
+						std::construct_at(&_slots[index], std::move(old_slots[i]));
+						std::destroy_at(&old_slots[i]);
+					}
+				}
+
+				if (old_capacity != 0) {
+					_ctrl_alloc.deallocate(old_ctrl, old_capacity + __width);
+					_slot_alloc.deallocate(old_slots, old_capacity);
+				}
+			}
+
+			/**
+			 * @brief Make room for another element, either by clearing out tombstones or by doubling the capacity
+			 *
+			 */
+			void __grow(void) {
+				if (_capacity != 0 && _size <= __max_growth(_capacity) / 2) {
+					// mostly tombstones, rehashing in place is enough
+					__resize(_capacity);
+				} else {
+					__resize(_capacity ? _capacity * 2 + 1 : __width - 1);
+				}
+			}
+
+			/**
+			 * @brief Remove the element in a slot, which must be full
+			 *
+			 */
+			void __erase_index(size_t index) {
+				std::destroy_at(&_slots[index]);
+				_size--;
+
+				// if there was never a full group around this slot, no probe can have passed through it and it can be
+				// marked empty instead of deleted
+				auto empty_before = __group(_ctrl + ((index - __width) & _capacity)).match_empty();
+				auto empty_after = __group(_ctrl + index).match_empty();
+				if (empty_before && empty_after &&
+					empty_after.trailing_zeros() + empty_before.leading_zeros() < __width) {
+					__set_ctrl(index, __ctrl_empty);
+					_growth_left++;
+				} else {
+					__set_ctrl(index, __ctrl_deleted);
+				}
+			}
+
+			[[nodiscard]] iterator __iterator_at(size_t index) {
+				return iterator(_ctrl + index, _slots + index);
+			}
+
+			[[nodiscard]] const_iterator __iterator_at(size_t index) const {
+				return const_iterator(_ctrl + index, _slots + index);
+			}
+
+		  public:
+			/**
+			 * @brief Find the slot for a key, preparing an empty slot for it if the key is not in the table
+			 *
+			 * @param key The key to find
+			 * @return The index of the slot, and true if the slot is new and the caller must construct a value in it
+			 */
+			std::pair<size_t, bool> __find_or_prepare(const Key &key) {
+				auto hash = __hash_of(key);
+				auto index = __find_index(key, hash);
+				if (index != _capacity) {
+					return {index, false};
+				}
+
+				if (_growth_left == 0) {
+					__grow();
+				}
+				index = __find_non_full(hash);
+				if (_ctrl[index] == __ctrl_empty) {
+					_growth_left--;
+				}
+				__set_ctrl(index, __h2(hash));
+				_size++;
+				return {index, true};
+			}
+
+			[[nodiscard]] Value &__slot(size_t index) {
+				return _slots[index];
+			}
+
+#pragma region Constructors
+			__hashtable(void) = default;
+
+			explicit __hashtable(size_t bucket_count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(),
+								 const allocator_type &alloc = allocator_type())
+				: _hash(hash), _equal(equal), _slot_alloc(alloc), _ctrl_alloc(alloc) {
+				if (bucket_count != 0) {
+					__allocate(__capacity_for(bucket_count));
+				}
+			}
+
+			__hashtable(const __hashtable &other)
+				: _hash(other._hash), _equal(other._equal), _slot_alloc(other._slot_alloc),
+				  _ctrl_alloc(other._ctrl_alloc) {
+				reserve(other._size);
+				for (auto &value : other) {
+					auto [index, inserted] = __find_or_prepare(KeyOf()(value));
+					std::construct_at(&_slots[index], value);
+				}
+			}
+
+			__hashtable(__hashtable &&other)
+				: _hash(std::move(other._hash)), _equal(std::move(other._equal)), _slot_alloc(other._slot_alloc),
+				  _ctrl_alloc(other._ctrl_alloc) {
+				swap(other);
+			}
+#pragma endregion
+
+			~__hashtable(void) {
+				__destroy();
+			}
+
+#pragma region Assignment Operators and Functions
+			__hashtable &operator=(const __hashtable &other) {
+				if (this != &other) {
+					__hashtable copy(other);
+					swap(copy);
+				}
+				return *this;
+			}
+
+			__hashtable &operator=(__hashtable &&other) {
+				if (this != &other) {
+					__destroy();
+					_capacity = 0;
+					_size = 0;
+					_growth_left = 0;
+					_ctrl = nullptr;
+					_slots = nullptr;
+					swap(other);
+				}
+				return *this;
+			}
+#pragma endregion
+
+			[[nodiscard]] allocator_type get_allocator(void) const {
+				return allocator_type(_slot_alloc);
+			}
+
+#pragma region Iterator Functions
+			[[nodiscard]] iterator begin(void) {
+				if (_size == 0) {
+					return end();
+				}
+				auto it = __iterator_at(0);
+				it.__skip_empty();
+				return it;
+			}
+
+			[[nodiscard]] const_iterator begin(void) const {
+				if (_size == 0) {
+					return end();
+				}
+				auto it = __iterator_at(0);
+				it.__skip_empty();
+				return it;
+			}
+
+			[[nodiscard]] const_iterator cbegin(void) const {
+				return begin();
+			}
+
+			[[nodiscard]] iterator end(void) {
+				return __iterator_at(_capacity);
+			}
+
+			[[nodiscard]] const_iterator end(void) const {
+				return __iterator_at(_capacity);
+			}
+
+			[[nodiscard]] const_iterator cend(void) const {
+				return end();
+			}
+#pragma endregion
+
+#pragma region Capacity Functions
+			[[nodiscard]] bool empty(void) const {
+				return _size == 0;
+			}
+
+			[[nodiscard]] size_t size(void) const {
+				return _size;
+			}
+
+			[[nodiscard]] size_t max_size(void) const {
+				return INTMAX_MAX / (sizeof(Value) + 1);
+			}
+#pragma endregion
+
+#pragma region Modifier Functions
+			void clear(void) {
+				if (_capacity == 0) {
+					return;
+				}
+				for (size_t i = 0; i < _capacity; i++) {
+					if (_ctrl[i] >= 0) {
+						std::destroy_at(&_slots[i]);
+					}
+				}
+				memset(_ctrl, __ctrl_empty, _capacity + __width);
+				_ctrl[_capacity] = __ctrl_sentinel;
+				_size = 0;
+				_growth_left = __max_growth(_capacity);
+			}
+
+			std::pair<iterator, bool> insert(const value_type &value) {
+				auto [index, inserted] = __find_or_prepare(KeyOf()(value));
+				if (inserted) {
+					std::construct_at(&_slots[index], value);
+				}
+				return {__iterator_at(index), inserted};
+			}
+
+			std::pair<iterator, bool> insert(value_type &&value) {
+				auto [index, inserted] = __find_or_prepare(KeyOf()(value));
+				if (inserted) {
+					std::construct_at(&_slots[index], std::move(value));
+				}
+				return {__iterator_at(index), inserted};
+			}
+
+			iterator insert(const_iterator, const value_type &value) {
+				return insert(value).first;
+			}
+
+			iterator insert(const_iterator, value_type &&value) {
+				return insert(std::move(value)).first;
+			}
+
+			template <typename Iter>
+			void insert(Iter first, Iter last) {
+				for (; first != last; ++first) {
+					insert(*first);
+				}
+			}
+
+			void insert(std::initializer_list<value_type> list) {
+				insert(list.begin(), list.end());
+			}
+
+			template <typename... Args>
+			std::pair<iterator, bool> emplace(Args &&...args) {
+				// the key is only known once the value has been constructed
+				value_type value(std::forward<Args>(args)...);
+				return insert(std::move(value));
+			}
+
+			template <typename... Args>
+			iterator emplace_hint(const_iterator, Args &&...args) {
+				return emplace(std::forward<Args>(args)...).first;
+			}
+
+			iterator erase(const_iterator pos) {
+				auto index = static_cast<size_t>(pos._ctrl - _ctrl);
+				__erase_index(index);
+				auto it = __iterator_at(index);
+				++it;
+				return it;
+			}
+
+			iterator erase(const_iterator first, const_iterator last) {
+				while (first != last) {
+					first = erase(first);
+				}
+				return __iterator_at(static_cast<size_t>(last._ctrl - _ctrl));
+			}
+
+			size_t erase(const Key &key) {
+				auto index = __find_index(key, __hash_of(key));
+				if (index == _capacity) {
+					return 0;
+				}
+				__erase_index(index);
+				return 1;
+			}
+
+			void swap(__hashtable &other) {
+				std::swap(_capacity, other._capacity);
+				std::swap(_size, other._size);
+				std::swap(_growth_left, other._growth_left);
+				std::swap(_ctrl, other._ctrl);
+				std::swap(_slots, other._slots);
+				std::swap(_hash, other._hash);
+				std::swap(_equal, other._equal);
+			}
+#pragma endregion
+
+#pragma region Lookup Functions
+			[[nodiscard]] size_t count(const Key &key) const {
+				return contains(key) ? 1 : 0;
+			}
+
+			[[nodiscard]] iterator find(const Key &key) {
+				return __iterator_at(__find_index(key, __hash_of(key)));
+			}
+
+			[[nodiscard]] const_iterator find(const Key &key) const {
+				return __iterator_at(__find_index(key, __hash_of(key)));
+			}
+
+			[[nodiscard]] bool contains(const Key &key) const {
+				return __find_index(key, __hash_of(key)) != _capacity;
+			}
+
+			[[nodiscard]] std::pair<iterator, iterator> equal_range(const Key &key) {
+				auto it = find(key);
+				if (it == end()) {
+					return {it, it};
+				}
+				auto next = it;
+				return {it, ++next};
+			}
+
+			[[nodiscard]] std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+				auto it = find(key);
+				if (it == end()) {
+					return {it, it};
+				}
+				auto next = it;
+				return {it, ++next};
+			}
+#pragma endregion
+
+#pragma region Hash Policy Functions
+			/**
+			 * @note There are no buckets, this is the number of slots
+			 */
+			[[nodiscard]] size_t bucket_count(void) const {
+				return _capacity;
+			}
+
+			[[nodiscard]] float load_factor(void) const {
+				return _capacity ? static_cast<float>(_size) / static_cast<float>(_capacity) : 0.0f;
+			}
+
+			/**
+			 * @note Fixed at 7/8
+			 */
+			[[nodiscard]] float max_load_factor(void) const {
+				return 0.875f;
+			}
+
+			void max_load_factor(float) {}
+
+			void rehash(size_t count) {
+				if (count < _size) {
+					count = _size;
+				}
+				if (count == 0 && _size == 0) {
+					__destroy();
+					_capacity = 0;
+					_growth_left = 0;
+					_ctrl = nullptr;
+					_slots = nullptr;
+					return;
+				}
+				__resize(__capacity_for(count));
+			}
+
+			void reserve(size_t count) {
+				if (count > _size + _growth_left) {
+					__resize(__capacity_for(count));
+				}
+			}
+#pragma endregion
+
+#pragma region Observer Functions
+			[[nodiscard]] hasher hash_function(void) const {
+				return _hash;
+			}
+
+			[[nodiscard]] key_equal key_eq(void) const {
+				return _equal;
+			}
+#pragma endregion
+		};
+
+		/**
+		 * @brief Check if two hash tables hold the same values, in any order
+		 *
+		 */
+		template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename A>
+		[[nodiscard]] bool __hashtable_equal(const __hashtable<Key, Value, KeyOf, Hash, KeyEqual, A> &lhs,
+											 const __hashtable<Key, Value, KeyOf, Hash, KeyEqual, A> &rhs) {
+			if (lhs.size() != rhs.size()) {
+				return false;
+			}
+			for (auto &value : lhs) {
+				auto it = rhs.find(KeyOf()(value));
+				if (it == rhs.end() || !(*it == value)) {
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-22
+ * @brief Random access iterator for containers that are indexed rather than contiguous
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <type_traits>
+
+#include <bits/iterator_traits.h>
+
+namespace std {
+	namespace __detail {
+		/**
+		 * @brief Random access iterator that holds a container and an index, and accesses elements through the
+		 * container's subscript operator
+		 *
+		 * @tparam Container The type of the container
+		 * @tparam Const Whether the iterator is a const iterator
+		 */
+		template <typename Container, bool Const>
+		struct __index_iterator {
+			using value_type = typename Container::value_type;
+			using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+			using reference = std::conditional_t<Const, const value_type &, value_type &>;
+			using difference_type = ptrdiff_t;
+			using iterator_category = std::random_access_iterator_tag;
+
+			std::conditional_t<Const, const Container *, Container *> _container = nullptr;
+			size_t _index = 0;
+
+			constexpr __index_iterator(void) = default;
+
+			constexpr __index_iterator(decltype(_container) container, size_t index) : _container(container), _index(index) {}
+
+			template <bool C = Const>
+				requires(C)
+			constexpr __index_iterator(const __index_iterator<Container, false> &other)
+				: _container(other._container), _index(other._index) {}
+
+			[[nodiscard]] constexpr reference operator*(void) const {
+				return (*_container)[_index];
+			}
+
+			[[nodiscard]] constexpr pointer operator->(void) const {
+				return &(*_container)[_index];
+			}
+
+			[[nodiscard]] constexpr reference operator[](difference_type n) const {
+				return (*_container)[_index + n];
+			}
+
+			constexpr __index_iterator &operator++(void) {
+				_index++;
+				return *this;
+			}
+
+			constexpr __index_iterator operator++(int) {
+				auto tmp = *this;
+				_index++;
+				return tmp;
+			}
+
+			constexpr __index_iterator &operator--(void) {
+				_index--;
+				return *this;
+			}
+
+			constexpr __index_iterator operator--(int) {
+				auto tmp = *this;
+				_index--;
+				return tmp;
+			}
+
+			constexpr __index_iterator &operator+=(difference_type n) {
+				_index += n;
+				return *this;
+			}
+
+			constexpr __index_iterator &operator-=(difference_type n) {
+				_index -= n;
+				return *this;
+			}
+
+			[[nodiscard]] constexpr friend __index_iterator operator+(__index_iterator it, difference_type n) {
+				return it += n;
+			}
+
+			[[nodiscard]] constexpr friend __index_iterator operator+(difference_type n, __index_iterator it) {
+				return it += n;
+			}
+
+			[[nodiscard]] constexpr friend __index_iterator operator-(__index_iterator it, difference_type n) {
+				return it -= n;
+			}
+
+			[[nodiscard]] constexpr friend difference_type operator-(const __index_iterator &lhs,
+																	 const __index_iterator &rhs) {
+				return static_cast<difference_type>(lhs._index - rhs._index);
+			}
+
+			[[nodiscard]] constexpr friend bool operator==(const __index_iterator &lhs, const __index_iterator &rhs) {
+				return lhs._index == rhs._index;
+			}
+
+			[[nodiscard]] constexpr friend auto operator<=>(const __index_iterator &lhs, const __index_iterator &rhs) {
+				return lhs._index <=> rhs._index;
+			}
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-21
+ * @brief Helpers shared by the intrusive containers
+ * @note This file is not part of the C++ standard library
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace std {
+	namespace __detail {
+		/**
+		 * @brief Get the object that contains a hook
+		 *
+		 * @tparam T The type of the object
+		 * @tparam H The type of the hook
+		 * @tparam Member The hook member of the object
+		 * @param hook The hook
+		 * @return The object that contains the hook
+		 *
+		 * @note offsetof cannot be used with a pointer to member, but under the Itanium ABI a pointer to data member
+		 * is the offset of the member
+		 */
+		template <typename T, typename H, H T::*Member>
+		[[nodiscard]] inline T *__intrusive_owner(H *hook) {
+			static_assert(sizeof(Member) == sizeof(ptrdiff_t), "unsupported pointer to member representation");
+			auto offset = __builtin_bit_cast(ptrdiff_t, Member);
+			return reinterpret_cast<T *>(reinterpret_cast<uintptr_t>(hook) - offset);
+		}
+
+		template <typename T, typename H, H T::*Member>
+		[[nodiscard]] inline const T *__intrusive_owner(const H *hook) {
+			return __intrusive_owner<T, H, Member>(const_cast<H *>(hook));
+		}
+	}
+}
\ No newline at end of file
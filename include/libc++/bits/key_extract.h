@@ -0,0 +1,39 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-20
+ * @brief Function objects that get the key of a value stored in an associative container
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+namespace std {
+	namespace __detail {
+		/**
+		 * @brief Key extractor for containers whose values are their keys
+		 *
+		 */
+		struct __key_identity {
+			template <typename T>
+			[[nodiscard]] constexpr const T &operator()(const T &value) const {
+				return value;
+			}
+		};
+
+		/**
+		 * @brief Key extractor for containers whose values are key-value pairs
+		 *
+		 */
+		struct __key_first {
+			template <typename T>
+			[[nodiscard]] constexpr const auto &operator()(const T &value) const {
+				return value.first;
+			}
+		};
+	}
+}
\ No newline at end of file
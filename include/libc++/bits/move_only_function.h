@@ -0,0 +1,332 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-26
+ * @brief Type-erased wrapper for move only callable objects
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include <bits/function.h>
+#include <cassert>
+#include <utility>
+
+namespace std {
+	namespace __detail {
+		/**
+		 * @brief Common implementation of move_only_function for each call qualifier
+		 *
+		 * @tparam Const Whether the callable is invoked as const
+		 * @tparam R The return type
+		 * @tparam Args The types of the arguments
+		 */
+		template <bool Const, typename R, typename... Args>
+		class __move_only_function_base {
+		  protected:
+			using vtable = __function_vtable<R, Args...>;
+
+			__function_storage _storage;
+			const vtable *_vtable = nullptr;
+
+			// the callable must be invocable with the same qualifiers as the wrapper
+			template <typename F>
+			static constexpr bool __is_callable = is_invocable_r_v<R, conditional_t<Const, const F, F> &, Args...>;
+
+			void __reset(void) {
+				if (_vtable) {
+					_vtable->_destroy(_storage);
+					_vtable = nullptr;
+				}
+			}
+
+			void __take(__move_only_function_base &other) {
+				if (other._vtable) {
+					other._vtable->_move(_storage, other._storage);
+					_vtable = other._vtable;
+					other._vtable = nullptr;
+				}
+			}
+
+			template <typename F, typename... CArgs>
+			void __emplace(CArgs &&...args) {
+				__function_emplace<F>(_storage, std::forward<CArgs>(args)...);
+				_vtable = &__function_vtable_for<F, false, Const, R, Args...>;
+			}
+
+			R __call(Args &&...args) const {
+				assert(_vtable);
+				return _vtable->_invoke(_storage, std::forward<Args>(args)...);
+			}
+
+		  public:
+			__move_only_function_base(void) noexcept = default;
+
+			__move_only_function_base(const __move_only_function_base &) = delete;
+			__move_only_function_base &operator=(const __move_only_function_base &) = delete;
+
+			~__move_only_function_base(void) {
+				__reset();
+			}
+
+			[[nodiscard]] explicit operator bool(void) const noexcept {
+				return _vtable != nullptr;
+			}
+		};
+	}
+
+	template <typename...>
+	class move_only_function;
+
+	/**
+	 * @brief Type-erased wrapper for any callable object, including ones that cannot be copied
+	 *
+	 * @tparam R The return type
+	 * @tparam Args The types of the arguments
+	 *
+	 * @details Callables of up to three pointers in size are stored inline, larger ones are allocated on the heap
+	 *
+	 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function @endlink
+	 */
+	template <typename R, typename... Args>
+	class move_only_function<R(Args...)> : public __detail::__move_only_function_base<false, R, Args...> {
+	  private:
+		using base = __detail::__move_only_function_base<false, R, Args...>;
+
+	  public:
+		using result_type = R;
+
+#pragma region Constructors
+		/**
+		 * @brief Construct a new empty move_only_function object
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/move_only_function @endlink
+		 */
+		move_only_function(void) noexcept = default;
+
+		/**
+		 * @brief Construct a new empty move_only_function object
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/move_only_function @endlink
+		 */
+		move_only_function(nullptr_t) noexcept {}
+
+		/**
+		 * @brief Construct a new move_only_function object
+		 *
+		 * @param other The move_only_function to move
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/move_only_function @endlink
+		 */
+		move_only_function(move_only_function &&other) noexcept {
+			this->__take(other);
+		}
+
+		/**
+		 * @brief Construct a new move_only_function object
+		 *
+		 * @tparam F The type of the callable
+		 * @param func The callable to wrap
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/move_only_function @endlink
+		 */
+		template <typename F>
+			requires(!is_same_v<remove_cvref_t<F>, move_only_function> && base::template __is_callable<decay_t<F>>)
+		move_only_function(F &&func) {
+			if (!__detail::__function_is_null(func)) {
+				this->template __emplace<decay_t<F>>(std::forward<F>(func));
+			}
+		}
+
+		/**
+		 * @brief Construct a new move_only_function object with a callable constructed in place
+		 *
+		 * @tparam F The type of the callable
+		 * @tparam CArgs The types of the arguments to construct the callable with
+		 * @param args The arguments to construct the callable with
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/move_only_function @endlink
+		 */
+		template <typename F, typename... CArgs>
+			requires(base::template __is_callable<F>)
+		explicit move_only_function(in_place_type_t<F>, CArgs &&...args) {
+			this->template __emplace<F>(std::forward<CArgs>(args)...);
+		}
+#pragma endregion
+
+#pragma region Assignment Operators
+		/**
+		 * @brief Moves the callable of the given move_only_function
+		 *
+		 * @param other The move_only_function to move
+		 * @return A reference to this move_only_function
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/operator%3D @endlink
+		 */
+		move_only_function &operator=(move_only_function &&other) noexcept {
+			if (this != &other) {
+				this->__reset();
+				this->__take(other);
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Destroys the wrapped callable
+		 *
+		 * @return A reference to this move_only_function
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/operator%3D @endlink
+		 */
+		move_only_function &operator=(nullptr_t) noexcept {
+			this->__reset();
+			return *this;
+		}
+
+		/**
+		 * @brief Replaces the wrapped callable
+		 *
+		 * @tparam F The type of the callable
+		 * @param func The callable to wrap
+		 * @return A reference to this move_only_function
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/operator%3D @endlink
+		 */
+		template <typename F>
+			requires(!is_same_v<remove_cvref_t<F>, move_only_function> && base::template __is_callable<decay_t<F>>)
+		move_only_function &operator=(F &&func) {
+			*this = move_only_function(std::forward<F>(func));
+			return *this;
+		}
+#pragma endregion
+
+		/**
+		 * @brief Swaps the callables of two move_only_functions
+		 *
+		 * @param other The move_only_function to swap with
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/swap @endlink
+		 */
+		void swap(move_only_function &other) noexcept {
+			move_only_function temp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temp);
+		}
+
+		/**
+		 * @brief Invokes the wrapped callable
+		 *
+		 * @param args The arguments to pass to the callable
+		 * @return The result of the callable
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/operator() @endlink
+		 */
+		R operator()(Args... args) {
+			return this->__call(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Check if a move_only_function is empty
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/operator%3D%3D @endlink
+		 */
+		[[nodiscard]] friend bool operator==(const move_only_function &func, nullptr_t) noexcept {
+			return !func;
+		}
+
+		/**
+		 * @brief Swaps the callables of two move_only_functions
+		 *
+		 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function/swap2 @endlink
+		 */
+		friend void swap(move_only_function &lhs, move_only_function &rhs) noexcept {
+			lhs.swap(rhs);
+		}
+	};
+
+	/**
+	 * @brief Type-erased wrapper for any const callable object, including ones that cannot be copied
+	 *
+	 * @tparam R The return type
+	 * @tparam Args The types of the arguments
+	 *
+	 * @link https://en.cppreference.com/w/cpp/utility/functional/move_only_function @endlink
+	 */
+	template <typename R, typename... Args>
+	class move_only_function<R(Args...) const> : public __detail::__move_only_function_base<true, R, Args...> {
+	  private:
+		using base = __detail::__move_only_function_base<true, R, Args...>;
+
+	  public:
+		using result_type = R;
+
+		move_only_function(void) noexcept = default;
+
+		move_only_function(nullptr_t) noexcept {}
+
+		move_only_function(move_only_function &&other) noexcept {
+			this->__take(other);
+		}
+
+		template <typename F>
+			requires(!is_same_v<remove_cvref_t<F>, move_only_function> && base::template __is_callable<decay_t<F>>)
+		move_only_function(F &&func) {
+			if (!__detail::__function_is_null(func)) {
+				this->template __emplace<decay_t<F>>(std::forward<F>(func));
+			}
+		}
+
+		template <typename F, typename... CArgs>
+			requires(base::template __is_callable<F>)
+		explicit move_only_function(in_place_type_t<F>, CArgs &&...args) {
+			this->template __emplace<F>(std::forward<CArgs>(args)...);
+		}
+
+		move_only_function &operator=(move_only_function &&other) noexcept {
+			if (this != &other) {
+				this->__reset();
+				this->__take(other);
+			}
+			return *this;
+		}
+
+		move_only_function &operator=(nullptr_t) noexcept {
+			this->__reset();
+			return *this;
+		}
+
+		template <typename F>
+			requires(!is_same_v<remove_cvref_t<F>, move_only_function> && base::template __is_callable<decay_t<F>>)
+		move_only_function &operator=(F &&func) {
+			*this = move_only_function(std::forward<F>(func));
+			return *this;
+		}
+
+		void swap(move_only_function &other) noexcept {
+			move_only_function temp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temp);
+		}
+
+		R operator()(Args... args) const {
+			return this->__call(std::forward<Args>(args)...);
+		}
+
+		[[nodiscard]] friend bool operator==(const move_only_function &func, nullptr_t) noexcept {
+			return !func;
+		}
+
+		friend void swap(move_only_function &lhs, move_only_function &rhs) noexcept {
+			lhs.swap(rhs);
+		}
+	};
+
+	// TODO noexcept and reference qualified signatures
+}
\ No newline at end of file
@@ -16,11 +16,11 @@
 #include <type_traits>
 
 #include <bits/iterator_traits.h>
-#include <list> // TODO replace with <deque>
+#include <deque>
 #include <utility>
 
 namespace std {
-	template <typename T, typename S = list<T>> // TODO replace with deque<T>
+	template <typename T, typename S = deque<T>>
 	class queue {
 	  public:
 		using container_type = S;
@@ -116,7 +116,7 @@ namespace std {
 	queue(Iter, Iter) -> queue<typename std::iterator_traits<Iter>::value_type>;
 
 	template <typename Iter, typename A>
-	queue(Iter, Iter, A) -> queue<typename std::iterator_traits<Iter>::value_type, std::list<typename std::iterator_traits<Iter>::value_type, A>>; // TODO replace with deque
+	queue(Iter, Iter, A) -> queue<typename std::iterator_traits<Iter>::value_type, std::deque<typename std::iterator_traits<Iter>::value_type, A>>;
 
 	template <typename T, typename S>
 	[[nodiscard]] constexpr inline bool operator==(const queue<T, S> &lhs, const queue<T, S> &rhs) {
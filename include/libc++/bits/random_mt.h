@@ -15,6 +15,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <span>
 
 namespace std {
 	namespace __detail {
@@ -76,36 +77,42 @@ namespace std {
 		/**
 		 * @brief Twist the internal state
 		 *
+		 * The loops are branchless so that the compiler can vectorize them.
 		 */
 		void __twist(void) {
 			const T upper_mask = (~T()) << r;
 			const T lower_mask = ~upper_mask;
 
 			for (size_t k = 0; k < n - m; k++) {
-				T x = (_state[k] & upper_mask) + (_state[k + 1] & lower_mask);
-				_state[k] = _state[k + m] ^ (x >> 1);
-				if (x & 1) {
-					_state[k] ^= a;
-				}
+				T x = (_state[k] & upper_mask) | (_state[k + 1] & lower_mask);
+				_state[k] = _state[k + m] ^ (x >> 1) ^ ((T(0) - (x & 1)) & a);
 			}
 
 			for (size_t k = n - m; k < n - 1; k++) {
-				T x = (_state[k] & upper_mask) + (_state[k + 1] & lower_mask);
-				_state[k] = _state[k + (m - n)] ^ (x >> 1);
-				if (x & 1) {
-					_state[k] ^= a;
-				}
+				T x = (_state[k] & upper_mask) | (_state[k + 1] & lower_mask);
+				_state[k] = _state[k + (m - n)] ^ (x >> 1) ^ ((T(0) - (x & 1)) & a);
 			}
 
-			T x = (_state[n - 1] & upper_mask) + (_state[0] & lower_mask);
-			_state[n - 1] = _state[m - 1] ^ (x >> 1);
-			if (x & 1) {
-				_state[n - 1] ^= a;
-			}
+			T x = (_state[n - 1] & upper_mask) | (_state[0] & lower_mask);
+			_state[n - 1] = _state[m - 1] ^ (x >> 1) ^ ((T(0) - (x & 1)) & a);
 
 			_index = 0;
 		}
 
+		/**
+		 * @brief Temper a state word into an output value
+		 *
+		 * @param value The state word
+		 * @return The tempered value
+		 */
+		[[nodiscard]] static constexpr T __temper(T value) {
+			value ^= (value >> u) & d;
+			value ^= (value << s) & b;
+			value ^= (value << t) & c;
+			value ^= (value >> l);
+			return value;
+		}
+
 	  public:
 		/**
 		 * @brief The word size
@@ -252,14 +259,35 @@ namespace std {
 				__twist();
 			}
 
-			T result = _state[_index];
-			result ^= (result >> u) & d;
-			result ^= (result << s) & b;
-			result ^= (result << t) & c;
-			result ^= (result >> l);
+			return __temper(_state[_index++]);
+		}
+
+		/**
+		 * @brief Fill a range with random numbers, the same values as calling
+		 * operator() once per element but tempering a block of the state at a time
+		 * @note This is not part of the C++ standard library
+		 *
+		 * @param out The range to fill
+		 */
+		void generate(std::span<T> out) {
+			T *dest = out.data();
+			size_t remaining = out.size();
 
-			_index++;
-			return result;
+			while (remaining > 0) {
+				if (_index >= n) {
+					__twist();
+				}
+
+				size_t count = n - _index < remaining ? n - _index : remaining;
+				const T *src = _state + _index;
+				for (size_t i = 0; i < count; i++) {
+					dest[i] = __temper(src[i]);
+				}
+
+				_index += count;
+				dest += count;
+				remaining -= count;
+			}
 		}
 
 		/**
@@ -0,0 +1,71 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-25
+ * @brief Moves objects to new storage and ends their lifetime at the old storage
+ * @note is_trivially_relocatable is not part of the C++ standard library
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include <bits/construct.h>
+#include <utility>
+
+namespace std {
+	/**
+	 * @brief Checks if moving an object to new storage and destroying the original is equivalent to copying its bytes
+	 *
+	 * @tparam T The type to check
+	 *
+	 * @note Specialize this for types which do not point into themselves, such as containers that own a heap buffer
+	 */
+	template <typename T>
+	struct is_trivially_relocatable : bool_constant<is_trivially_copyable_v<T>> {};
+
+	template <typename T>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+	namespace __detail {
+		/**
+		 * @brief Relocate the objects in [first, last) to the (possibly overlapping) storage starting at dest
+		 *
+		 * @tparam T The type of the objects
+		 * @param first The beginning of the range
+		 * @param last The end of the range
+		 * @param dest The beginning of the destination storage
+		 *
+		 * @note The objects in [first, last) are no longer alive afterwards and the destination must not contain any
+		 */
+		template <typename T>
+		constexpr void __relocate(T *first, T *last, T *dest) {
+			if (first == dest || first == last) {
+				return;
+			}
+			if (!std::is_constant_evaluated() && is_trivially_relocatable_v<T>) {
+				__builtin_memmove(static_cast<void *>(dest), static_cast<const void *>(first),
+								  static_cast<size_t>(last - first) * sizeof(T));
+			} else if (dest < first) {
+				for (; first != last; ++first, ++dest) {
+					std::construct_at(dest, std::move(*first));
+					std::destroy_at(first);
+				}
+			} else {
+				dest += last - first;
+				while (last != first) {
+					--last;
+					--dest;
+					std::construct_at(dest, std::move(*last));
+					std::destroy_at(last);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
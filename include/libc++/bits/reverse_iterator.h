@@ -50,7 +50,7 @@ namespace std {
 		}
 
 		template <typename U>
-		static constexpr U *__to_ptr(U p) {
+		static constexpr auto __to_ptr(U p) {
 			return p.operator->();
 		}
 
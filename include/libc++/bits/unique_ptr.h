@@ -16,6 +16,7 @@
 #include <compare>
 #include <type_traits>
 
+#include <bits/relocate.h>
 #include <utility>
 
 namespace std {
@@ -306,6 +307,10 @@ namespace std {
 		lhs.swap(rhs);
 	}
 
+	// a unique_ptr is only a pointer, so it can be relocated with memcpy
+	template <typename T>
+	struct is_trivially_relocatable<unique_ptr<T>> : true_type {};
+
 	// TODO hash
 
 	// The below functions rely on the array specialization of unique_ptr.
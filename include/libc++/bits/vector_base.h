@@ -20,9 +20,11 @@
 #include <bits/allocator.h>
 #include <bits/allocator_traits.h>
 #include <bits/construct.h>
+#include <bits/relocate.h>
 #include <bits/reverse_iterator.h>
 #include <cassert>
 #include <cstring>
+#include <iterator>
 #include <memory_resource>
 #include <optional>
 #include <utility>
@@ -53,43 +55,166 @@ namespace std {
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
 	  private:
-		T *_data;
-		size_t _size;
-		size_t _capacity;
+		T *_data = nullptr;
+		size_t _size = 0;
+		size_t _capacity = 0;
 		[[no_unique_address]] allocator_type _alloc;
 
+		// a range of Iter can be copied into the vector with memcpy
+		template <typename Iter>
+		static constexpr bool __is_memcpy_source = std::is_pointer_v<Iter> &&
+												   std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Iter>>, T> &&
+												   std::is_trivially_copyable_v<T>;
+
+		/**
+		 * @brief Try to grow the storage to the given capacity without moving it
+		 *
+		 * @param cap The capacity to grow to
+		 * @return true if the storage was grown, false otherwise
+		 */
+		constexpr bool __try_expand(size_t cap) {
+			if constexpr (requires(A &alloc, T *ptr, size_t n) { alloc.expand(ptr, n, n); }) {
+				if (!std::is_constant_evaluated() && _data && _alloc.expand(_data, _capacity, cap)) {
+					_capacity = cap;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Change the capacity, relocating the elements if the storage cannot be grown in place
+		 *
+		 * @param cap The new capacity, must be at least the size
+		 */
+		constexpr void __reallocate(size_t cap) {
+			if (cap > _capacity && __try_expand(cap)) {
+				return;
+			}
+
+			T *new_data = _alloc.allocate(cap);
+			assert(new_data);
+			__detail::__relocate(_data, _data + _size, new_data);
+
+			if (_data) {
+				_alloc.deallocate(_data, _capacity);
+			}
+			_data = new_data;
+			_capacity = cap;
+		}
+
+		/**
+		 * @brief Get the capacity to grow to when inserting the given number of elements
+		 *
+		 * @param count The number of elements being inserted
+		 * @return The new capacity
+		 */
+		[[nodiscard]] constexpr size_t __grow_capacity(size_t count) const {
+			return std::max(_capacity * 2, _size + count);
+		}
+
 		/**
-		 * @brief Inserts space for the given number of elements at the given pointer
+		 * @brief Inserts uninitialized space for the given number of elements at the given pointer
 		 *
 		 * @param ptr The pointer to insert space at
 		 * @param count The number of elements to insert
-		 * @param exp_growth Whether or not to use exponential growth
-		 * @param copy_data Whether or not to copy the data from the old array to the new one
 		 * @return The pointer to the inserted space
+		 *
+		 * @note The size is not changed, the caller must construct the elements and then add count to it
 		 */
-		constexpr T *__insert_space(T *ptr, size_t count, bool exp_growth = true, bool copy_data = true) {
-			if (_capacity >= _size + count) {
-				if (copy_data) {
-					std::move(ptr, end(), ptr + count);
+		constexpr T *__insert_space(T *ptr, size_t count) {
+			auto offset = ptr - _data;
+
+			if (_size + count > _capacity) {
+				size_t new_capacity = __grow_capacity(count);
+				if (!__try_expand(new_capacity)) {
+					T *new_data = _alloc.allocate(new_capacity);
+					assert(new_data);
+
+					__detail::__relocate(_data, ptr, new_data);
+					__detail::__relocate(ptr, _data + _size, new_data + offset + count);
+
+					if (_data) {
+						_alloc.deallocate(_data, _capacity);
+					}
+					_data = new_data;
+					_capacity = new_capacity;
+					return new_data + offset;
 				}
-			} else {
-				size_t new_capacity = exp_growth ? std::max(_capacity * 2, _size + count) : _size + count;
+				ptr = _data + offset;
+			}
 
-				T *new_data = _alloc.allocate(new_capacity);
-				assert(new_data);
+			__detail::__relocate(ptr, _data + _size, ptr + count);
+			return ptr;
+		}
 
-				auto len = ptr - _data;
-				if (copy_data) {
-					std::move(begin(), ptr, new_data);
-					std::move(ptr, end(), new_data + count + len);
+		/**
+		 * @brief Construct elements from a range in uninitialized storage
+		 *
+		 * @tparam Iter The type of the iterator
+		 * @param dest The storage to construct the elements in
+		 * @param first The beginning of the range
+		 * @param count The number of elements in the range
+		 */
+		template <typename Iter>
+		constexpr void __construct_range(T *dest, Iter first, size_t count) {
+			if constexpr (__is_memcpy_source<Iter>) {
+				if (!std::is_constant_evaluated()) {
+					if (count) {
+						memcpy(dest, first, count * sizeof(T));
+					}
+					return;
 				}
+			}
+			for (size_t i = 0; i < count; i++, ++first) {
+				std::construct_at(dest + i, *first);
+			}
+		}
 
-				_alloc.deallocate(_data, _capacity);
-				_data = new_data;
-				_capacity = new_capacity;
-				ptr = new_data + len;
+		/**
+		 * @brief Replace the contents of the vector with the elements of a range
+		 *
+		 * @tparam Iter The type of the iterator
+		 * @param first The beginning of the range
+		 * @param count The number of elements in the range
+		 */
+		template <typename Iter>
+		constexpr void __assign_range(Iter first, size_t count) {
+			clear();
+			if (count > _capacity) {
+				__reallocate(count);
+			}
+			__construct_range(_data, first, count);
+			_size = count;
+		}
+
+		/**
+		 * @brief Constructs an element at the end of the vector when there is no space left for it
+		 *
+		 * @tparam Args The types of the arguments to construct the element with
+		 * @param args The arguments to construct the element with
+		 * @return Pointer to the inserted element
+		 */
+		template <typename... Args>
+		constexpr T *__emplace_back_slow(Args &&...args) {
+			size_t new_capacity = __grow_capacity(1);
+			if (__try_expand(new_capacity)) {
+				return std::construct_at(_data + _size++, std::forward<Args>(args)...);
 			}
 
+			T *new_data = _alloc.allocate(new_capacity);
+			assert(new_data);
+
+			// construct before relocating, the arguments may refer to elements of this vector
+			auto ptr = std::construct_at(new_data + _size, std::forward<Args>(args)...);
+			__detail::__relocate(_data, _data + _size, new_data);
+
+			if (_data) {
+				_alloc.deallocate(_data, _capacity);
+			}
+			_data = new_data;
+			_capacity = new_capacity;
+			_size++;
 			return ptr;
 		}
 
@@ -120,14 +245,8 @@ namespace std {
 		 *
 		 * @link https://en.cppreference.com/w/cpp/container/vector/vector @endlink
 		 */
-		constexpr vector(size_t count, const T &value, const allocator_type &alloc = allocator_type())
-			: _size(count), _capacity(count), _alloc(alloc) {
-			_data = _alloc.allocate(count);
-			assert(_data);
-
-			for (size_t i = 0; i < count; i++) {
-				_data[i] = value;
-			}
+		constexpr vector(size_t count, const T &value, const allocator_type &alloc = allocator_type()) : _alloc(alloc) {
+			assign(count, value);
 		}
 
 		/**
@@ -138,14 +257,8 @@ namespace std {
 		 *
 		 * @link https://en.cppreference.com/w/cpp/container/vector/vector @endlink
 		 */
-		constexpr explicit vector(size_t count, const allocator_type &alloc = allocator_type())
-			: _size(count), _capacity(count), _alloc(alloc) {
-			_data = _alloc.allocate(count);
-			assert(_data);
-
-			for (size_t i = 0; i < count; i++) {
-				std::construct_at<T>(&_data[i]);
-			}
+		constexpr explicit vector(size_t count, const allocator_type &alloc = allocator_type()) : _alloc(alloc) {
+			resize(count);
 		}
 
 		/**
@@ -162,14 +275,7 @@ namespace std {
 		constexpr vector(Iter first, Iter last, const allocator_type &alloc = allocator_type())
 			requires(!std::is_integral_v<Iter>)
 			: _alloc(alloc) {
-			_data = _alloc.allocate(last - first); // TODO Use std::distance
-			assert(_data);
-
-			size_t i = 0;
-			for (auto &item = first; item != last; item++) {
-				_data[i++] = *item;
-			}
-			_size = i;
+			assign(first, last);
 		}
 
 		/**
@@ -179,14 +285,8 @@ namespace std {
 		 *
 		 * @link https://en.cppreference.com/w/cpp/container/vector/vector @endlink
 		 */
-		constexpr vector(const vector &other)
-			: _size(other._size), _capacity(other._size), _alloc(other._alloc) {
-			_data = _alloc.allocate(other._size);
-			assert(_data);
-
-			for (size_t i = 0; i < other._size; i++) {
-				_data[i] = other._data[i];
-			}
+		constexpr vector(const vector &other) : _alloc(other._alloc) {
+			__assign_range(other._data, other._size);
 		}
 
 		/**
@@ -197,14 +297,8 @@ namespace std {
 		 *
 		 * @link https://en.cppreference.com/w/cpp/container/vector/vector @endlink
 		 */
-		constexpr vector(const vector &other, const allocator_type &alloc)
-			: _size(other._size), _capacity(other._size), _alloc(alloc) {
-			_data = _alloc.allocate(other._size);
-			assert(_data);
-
-			for (size_t i = 0; i < other._size; i++) {
-				_data[i] = other._data[i];
-			}
+		constexpr vector(const vector &other, const allocator_type &alloc) : _alloc(alloc) {
+			__assign_range(other._data, other._size);
 		}
 
 		/**
@@ -219,6 +313,7 @@ namespace std {
 			_data = other._data;
 			other._data = nullptr;
 			other._size = 0;
+			other._capacity = 0;
 		}
 
 		/**
@@ -235,10 +330,12 @@ namespace std {
 				_data = other._data;
 				other._data = nullptr;
 				other._size = 0;
+				other._capacity = 0;
 			} else {
 				_data = _alloc.allocate(other._capacity);
 				assert(_data);
-				std::move(other.begin(), other.end(), _data);
+				__detail::__relocate(other._data, other._data + other._size, _data);
+				other._size = 0;
 			}
 		}
 
@@ -250,15 +347,8 @@ namespace std {
 		 *
 		 * @link https://en.cppreference.com/w/cpp/container/vector/vector @endlink
 		 */
-		constexpr vector(std::initializer_list<T> list, const allocator_type &alloc = allocator_type())
-			: _size(list.size()), _capacity(list.size()), _alloc(alloc) {
-			_data = _alloc.allocate(list.size());
-			assert(_data);
-
-			size_t i = 0;
-			for (auto &item : list) {
-				_data[i++] = item;
-			}
+		constexpr vector(std::initializer_list<T> list, const allocator_type &alloc = allocator_type()) : _alloc(alloc) {
+			__assign_range(list.begin(), list.size());
 		}
 #pragma endregion
 
@@ -276,13 +366,7 @@ namespace std {
 				return *this;
 			}
 
-			__insert_space(_data, other._size - _size, false, false);
-			_size = other._size;
-
-			for (size_t i = 0; i < _size; i++) {
-				_data[i] = other._data[i];
-			}
-
+			__assign_range(other._data, other._size);
 			return *this;
 		}
 
@@ -314,14 +398,7 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/operator%3D @endlink
 		 */
 		constexpr vector &operator=(std::initializer_list<T> list) {
-			__insert_space(_data, list.size() - _size, false, false);
-			_size = list.size();
-
-			size_t i = 0;
-			for (auto &item : list) {
-				_data[i++] = item;
-			}
-
+			__assign_range(list.begin(), list.size());
 			return *this;
 		}
 
@@ -334,12 +411,14 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/assign @endlink
 		 */
 		constexpr void assign(size_t count, const T &value) {
-			__insert_space(_data, count - _size, false, false);
-			_size = count;
-
+			clear();
+			if (count > _capacity) {
+				__reallocate(count);
+			}
 			for (size_t i = 0; i < count; i++) {
-				_data[i] = value;
+				std::construct_at(_data + i, value);
 			}
+			_size = count;
 		}
 
 		/**
@@ -355,13 +434,14 @@ namespace std {
 		constexpr void assign(Iter first, Iter last)
 			requires(!std::is_integral_v<Iter>)
 		{
-			auto len = last - first; // TODO Use std::distance
-			__insert_space(_data, len - _size, false, false);
-			_size = len;
-
-			size_t i = 0;
-			for (auto &item = first; item != last; item++) {
-				_data[i++] = *item;
+			using category = typename iterator_traits<Iter>::iterator_category;
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+				__assign_range(first, std::distance(first, last));
+			} else {
+				clear();
+				for (; first != last; ++first) {
+					emplace_back(*first);
+				}
 			}
 		}
 
@@ -373,13 +453,7 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/assign @endlink
 		 */
 		constexpr void assign(std::initializer_list<T> list) {
-			__insert_space(_data, list.size() - _size, false, false);
-			_size = list.size();
-
-			size_t i = 0;
-			for (auto &item : list) {
-				_data[i++] = item;
-			}
+			__assign_range(list.begin(), list.size());
 		}
 #pragma endregion
 
@@ -388,7 +462,9 @@ namespace std {
 		 */
 		constexpr ~vector(void) {
 			clear();
-			_alloc.deallocate(_data, _capacity);
+			if (_data) {
+				_alloc.deallocate(_data, _capacity);
+			}
 		}
 
 		/**
@@ -456,17 +532,10 @@ namespace std {
 		 */
 		constexpr void reserve(size_t cap) {
 			assert(cap < max_size());
-			if (cap < _capacity) {
+			if (cap <= _capacity) {
 				return;
 			}
-
-			T *new_data = _alloc.allocate(cap);
-			assert(new_data);
-			std::move(begin(), end(), new_data);
-
-			_alloc.deallocate(_data, _capacity);
-			_data = new_data;
-			_capacity = cap;
+			__reallocate(cap);
 		}
 
 		/**
@@ -478,14 +547,13 @@ namespace std {
 			if (_capacity == _size) {
 				return;
 			}
-
-			T *new_data = _alloc.allocate(_size);
-			assert(new_data);
-			std::move(begin(), end(), new_data);
-
-			_alloc.deallocate(_data, _capacity);
-			_data = new_data;
-			_capacity = _size;
+			if (_size == 0) {
+				_alloc.deallocate(_data, _capacity);
+				_data = nullptr;
+				_capacity = 0;
+				return;
+			}
+			__reallocate(_size);
 		}
 #pragma endregion
 
@@ -784,12 +852,12 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/erase @endlink
 		 */
 		constexpr T *erase(const T *first, const T *last) {
-			for (auto item = first; item != last; item++) {
-				std::destroy_at(&item);
+			auto ptr = const_cast<T *>(first);
+			for (auto item = ptr; item != last; item++) {
+				std::destroy_at(item);
 			}
 
-			auto ptr = const_cast<T *>(first);
-			std::move(const_cast<T *>(last), end(), ptr);
+			__detail::__relocate(const_cast<T *>(last), end(), ptr);
 
 			_size -= (last - first);
 			return ptr;
@@ -801,7 +869,8 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/pop_back @endlink
 		 */
 		constexpr void pop_back(void) {
-			erase(_data + _size - 1);
+			assert(_size > 0);
+			std::destroy_at(_data + --_size);
 		}
 
 		/**
@@ -814,10 +883,7 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/insert @endlink
 		 */
 		constexpr T *insert(const T *pos, const T &value) {
-			auto ptr = __insert_space(const_cast<T *>(pos), 1);
-			*ptr = value;
-			_size++;
-			return ptr;
+			return emplace(pos, value);
 		}
 
 		/**
@@ -830,10 +896,7 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/insert @endlink
 		 */
 		constexpr T *insert(const T *pos, T &&value) {
-			auto ptr = __insert_space(const_cast<T *>(pos), 1);
-			*ptr = std::move(value);
-			_size++;
-			return ptr;
+			return emplace(pos, std::move(value));
 		}
 
 		/**
@@ -847,10 +910,16 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/insert @endlink
 		 */
 		constexpr T *insert(const T *pos, size_t count, const T &value) {
+			if (count == 0) {
+				return const_cast<T *>(pos);
+			}
+
+			// copy first, the value may be an element of this vector
+			T copy(value);
 			auto ptr = __insert_space(const_cast<T *>(pos), count);
 
 			for (size_t i = 0; i < count; i++) {
-				ptr[i] = value;
+				std::construct_at(ptr + i, copy);
 			}
 
 			_size += count;
@@ -872,15 +941,31 @@ namespace std {
 		constexpr T *insert(const T *pos, Iter first, Iter last)
 			requires(!std::is_integral_v<Iter>)
 		{
-			auto ptr = __insert_space(const_cast<T *>(pos), last - first); // TODO Use std::distance
-
-			size_t i = 0;
-			for (auto item = first; item != last; item++) {
-				ptr[i++] = *item;
+			using category = typename iterator_traits<Iter>::iterator_category;
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+				// the size is known, so make space once and construct in place
+				size_t count = std::distance(first, last);
+				auto ptr = __insert_space(const_cast<T *>(pos), count);
+				__construct_range(ptr, first, count);
+				_size += count;
+				return ptr;
+			} else {
+				// single pass, append then rotate into place
+				auto offset = pos - _data;
+				auto old_size = _size;
+				for (; first != last; ++first) {
+					emplace_back(*first);
+				}
+				auto reverse = [](T *from, T *to) {
+					while (from + 1 < to) {
+						std::iter_swap(from++, --to);
+					}
+				};
+				reverse(_data + offset, _data + old_size);
+				reverse(_data + old_size, _data + _size);
+				reverse(_data + offset, _data + _size);
+				return _data + offset;
 			}
-			_size += i;
-
-			return ptr;
 		}
 
 		/**
@@ -893,15 +978,39 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/insert @endlink
 		 */
 		constexpr T *insert(const T *pos, std::initializer_list<T> list) {
-			auto ptr = __insert_space(const_cast<T *>(pos), list.size());
+			return insert(pos, list.begin(), list.end());
+		}
 
-			size_t i = 0;
-			for (auto &item : list) {
-				ptr[i++] = item;
-			}
-			_size += i;
+		/**
+		 * @brief Inserts the elements of the given range before the given position
+		 *
+		 * @tparam R The type of the range
+		 * @param pos The position to insert the values before
+		 * @param range The range to insert
+		 * @return Pointer to the first inserted value
+		 *
+		 * @link https://en.cppreference.com/w/cpp/container/vector/insert_range @endlink
+		 */
+		template <typename R>
+		constexpr T *insert_range(const T *pos, R &&range)
+			requires requires { range.begin(), range.end(); }
+		{
+			return insert(pos, range.begin(), range.end());
+		}
 
-			return ptr;
+		/**
+		 * @brief Inserts the elements of the given range at the end of the vector
+		 *
+		 * @tparam R The type of the range
+		 * @param range The range to insert
+		 *
+		 * @link https://en.cppreference.com/w/cpp/container/vector/append_range @endlink
+		 */
+		template <typename R>
+		constexpr void append_range(R &&range)
+			requires requires { range.begin(), range.end(); }
+		{
+			insert(end(), range.begin(), range.end());
 		}
 
 		/**
@@ -912,9 +1021,7 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/push_back @endlink
 		 */
 		constexpr void push_back(const T &value) {
-			auto ptr = __insert_space(_data + _size, 1);
-			*ptr = value;
-			_size++;
+			emplace_back(value);
 		}
 
 		/**
@@ -925,9 +1032,7 @@ namespace std {
 		 * @link https://en.cppreference.com/w/cpp/container/vector/push_back @endlink
 		 */
 		constexpr void push_back(T &&value) {
-			auto ptr = __insert_space(_data + _size, 1);
-			*ptr = std::move(value);
-			_size++;
+			emplace_back(std::move(value));
 		}
 
 		/**
@@ -942,8 +1047,14 @@ namespace std {
 		 */
 		template <typename... Args>
 		constexpr T *emplace(const T *pos, Args &&...args) {
+			if (pos == end()) {
+				return &emplace_back(std::forward<Args>(args)...);
+			}
+
+			// construct first, the arguments may refer to elements of this vector
+			T value(std::forward<Args>(args)...);
 			auto ptr = __insert_space(const_cast<T *>(pos), 1);
-			std::construct_at(ptr, std::forward<Args>(args)...);
+			std::construct_at(ptr, std::move(value));
 			_size++;
 			return ptr;
 		}
@@ -959,10 +1070,10 @@ namespace std {
 		 */
 		template <typename... Args>
 		constexpr T &emplace_back(Args &&...args) {
-			auto ptr = __insert_space(_data + _size, 1);
-			std::construct_at(ptr, std::forward<Args>(args)...);
-			_size++;
-			return *ptr;
+			if (_size < _capacity) [[likely]] {
+				return *std::construct_at(_data + _size++, std::forward<Args>(args)...);
+			}
+			return *__emplace_back_slow(std::forward<Args>(args)...);
 		}
 
 		/**
@@ -978,10 +1089,11 @@ namespace std {
 					std::destroy_at(&_data[i]);
 				}
 			} else if (count > _size) {
-				auto ptr = __insert_space(_data + _size, count - _size, false);
-
-				for (size_t i = 0; i < count - _size; i++) {
-					std::construct_at(&ptr[i]);
+				if (count > _capacity) {
+					__reallocate(count);
+				}
+				for (size_t i = _size; i < count; i++) {
+					std::construct_at(_data + i);
 				}
 			}
 
@@ -1002,10 +1114,13 @@ namespace std {
 					std::destroy_at(&_data[i]);
 				}
 			} else if (count > _size) {
-				auto ptr = __insert_space(_data + _size, count - _size, false);
-
-				for (size_t i = 0; i < count - _size; i++) {
-					ptr[i] = value;
+				// copy first, the value may be an element of this vector
+				T copy(value);
+				if (count > _capacity) {
+					__reallocate(count);
+				}
+				for (size_t i = _size; i < count; i++) {
+					std::construct_at(_data + i, copy);
 				}
 			}
 
@@ -1027,6 +1142,10 @@ namespace std {
 #pragma endregion
 	};
 
+	// a vector only points to its heap storage, so it can be relocated with memcpy
+	template <typename T>
+	struct is_trivially_relocatable<vector<T, allocator<T>>> : true_type {};
+
 	// Deduction guides
 	// https://en.cppreference.com/w/cpp/container/vector/deduction_guides
 
@@ -166,6 +166,19 @@ int rand_r(unsigned int *seed);
  */
 void srand(unsigned int seed);
 
+/**
+ * @brief Sort an array
+ *
+ * @param base The start of the array
+ * @param count The number of elements in the array
+ * @param size The size of an element
+ * @param compare The comparison function, returns less than, equal to or greater than 0 if the first argument is less
+ * than, equal to or greater than the second
+ *
+ * @link https://pubs.opengroup.org/onlinepubs/9699919799/functions/qsort.html @endlink
+ */
+void qsort(void *base, size_t count, size_t size, int (*compare)(const void *, const void *));
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -74,12 +74,13 @@ gdt:
 .kdata: equ $ - gdt
 	dq (1 << 41) | (1 << 44) | (1 << 47) | (1 << 53)	; Kernel data segment entry
 	; writeable, code/data type, present, 64-bit
-.ucode: equ $ - gdt
-	dq (1 << 43) | (1 << 44) | (3 << 45) | (1 << 47) | (1 << 53)	; User code segment entry
-	; executable, code/data type, user mode, present, 64-bit
 .udata: equ $ - gdt
 	dq (1 << 41) | (1 << 44) | (3 << 45) | (1 << 47) | (1 << 53)	; User data segment entry
 	; writeable, code/data type, user mode, present, 64-bit
+	; NOTE: must directly precede user code, SYSRET loads SS = STAR[63:48] + 8 and CS = STAR[63:48] + 16
+.ucode: equ $ - gdt
+	dq (1 << 43) | (1 << 44) | (3 << 45) | (1 << 47) | (1 << 53)	; User code segment entry
+	; executable, code/data type, user mode, present, 64-bit
 .tss: equ $ - gdt
 	resb 16	; Task state segment entry (filled programmatically later in boot process)
 .pointer:					; Value used by LGDT
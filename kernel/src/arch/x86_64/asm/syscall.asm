@@ -0,0 +1,121 @@
+; Copyright (c) 2024, Jayden Grubb
+; All rights reserved.
+; 
+; This source code is licensed under the BSD-style license found in the
+; LICENSE file in the root directory of this source tree.
+
+section .text
+bits 64
+
+; offsets into PerCPU (see syscall.cpp)
+%define PERCPU_KERNEL_RSP 0
+%define PERCPU_USER_RSP 8
+
+; user segment selectors loaded by sysret (see gdt.h), with RPL 3
+%define USER_SS (0x18 | 3)
+%define USER_CS (0x20 | 3)
+
+extern syscall_dispatch
+
+global syscall_entry
+syscall_entry:
+	; set by cpu: rcx = user rip, r11 = user rflags
+	; interrupts are masked by IA32_FMASK
+	swapgs
+	mov [gs:PERCPU_USER_RSP], rsp
+	mov rsp, [gs:PERCPU_KERNEL_RSP]
+
+	; build Syscall::Frame
+	push qword [gs:PERCPU_USER_RSP]
+	push r11
+	push rcx
+	push r9
+	push r8
+	push r10
+	push rdx
+	push rsi
+	push rdi
+	push rax
+	sti
+
+	mov rdi, rsp
+	call syscall_dispatch
+
+	; restore caller, rax holds the return value
+	cli
+	add rsp, 8
+	pop rdi
+	pop rsi
+	pop rdx
+	pop r10
+	pop r8
+	pop r9
+	pop rcx
+	pop r11
+
+	; sysret with a non-canonical rip raises #GP in ring 0 after the user rsp is loaded,
+	; so the handler would run on a stack the user controls. return with iretq instead,
+	; which faults on the kernel stack
+	push rcx
+	shl rcx, 16
+	sar rcx, 16
+	cmp rcx, [rsp]
+	pop rcx
+	jne .iret
+
+	pop rsp
+	swapgs
+	o64 sysret
+
+.iret:
+	; [rsp] is the user rsp, build an interrupt frame around it
+	pop qword [gs:PERCPU_USER_RSP]
+	push qword USER_SS
+	push qword [gs:PERCPU_USER_RSP]
+	push r11
+	push qword USER_CS
+	push rcx
+	swapgs
+	iretq
+
+global syscall_interrupt
+syscall_interrupt:
+	; pushed by cpu: ss, rsp, rflags, cs, rip
+	; clobbered by syscall_dispatch but preserved for the caller
+	push rcx
+	push r11
+
+	; build Syscall::Frame
+	push qword [rsp + 40]	; rsp
+	push qword [rsp + 40]	; rflags
+	push qword [rsp + 32]	; rip
+	push r9
+	push r8
+	push r10
+	push rdx
+	push rsi
+	push rdi
+	push rax
+	sti
+
+	; keep stack 16-byte aligned for the call
+	mov rdi, rsp
+	sub rsp, 8
+	call syscall_dispatch
+	add rsp, 8
+
+	; restore caller, rax holds the return value
+	cli
+	add rsp, 8
+	pop rdi
+	pop rsi
+	pop rdx
+	pop r10
+	pop r8
+	pop r9
+	add rsp, 24
+	pop r11
+	pop rcx
+
+	; popped by cpu: rip, cs, rflags, rsp, ss
+	iretq
\ No newline at end of file
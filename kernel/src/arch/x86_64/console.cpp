@@ -0,0 +1,82 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-14
+ * @brief Maps file descriptors to persistent console devices
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <new>
+
+#include <kernel/arch/x86_64/console.h>
+#include <kernel/debug.h>
+
+static constexpr UART::UARTPort ports[] = {UART::COM1, UART::COM2, UART::COM3, UART::COM4};
+
+// constructed on first use as logging starts before global constructors are run
+alignas(UART) static uint8_t uart_storage[4][sizeof(UART)];
+static UART *uarts[4];
+
+// stdin, stdout and stderr all default to COM1
+static UART::UARTPort fd_ports[Console::MAX_FDS] = {UART::COM1, UART::COM1, UART::COM1};
+
+UART &Console::get_port(UART::UARTPort port) {
+	size_t index = 0;
+	while (ports[index] != port) {
+		index++;
+	}
+
+	if (uarts[index] == nullptr) {
+		uarts[index] = new (uart_storage[index]) UART(port);
+	}
+	return *uarts[index];
+}
+
+void Console::init(void) {
+	Debug::log("Initializing console...");
+
+	for (int fd = 0; fd < MAX_FDS; fd++) {
+		if (!get_port(fd_ports[fd]).enableInterrupts()) {
+			Debug::log_failure("Failed to enable interrupts for console fd %d", fd);
+		}
+	}
+
+	Debug::log_ok("Console initialized");
+}
+
+UART *Console::get_device(int fd) {
+	if (fd < 0 || fd >= MAX_FDS) {
+		return nullptr;
+	}
+	return &get_port(fd_ports[fd]);
+}
+
+bool Console::set_device(int fd, UART::UARTPort port) {
+	if (fd < 0 || fd >= MAX_FDS) {
+		Debug::log_failure("Cannot map invalid console fd %d", fd);
+		return false;
+	}
+
+	fd_ports[fd] = port;
+	return true;
+}
+
+ssize_t Console::write(int fd, std::span<const uint8_t> data) {
+	auto device = get_device(fd);
+	if (device == nullptr) {
+		return -1;
+	}
+	return device->write(data);
+}
+
+void Console::flush(void) {
+	for (auto uart : uarts) {
+		if (uart) {
+			uart->flush();
+		}
+	}
+}
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include <kernel/arch/x86_64/multiboot2.h>
 #include <kernel/debug.h>
 #include <kernel/defines.h>
+#include <kernel/initcall.h>
 
 using namespace Graphics;
 
@@ -25,6 +26,19 @@ static uint32_t _width = 0;
 static uint32_t _height = 0;
 static uint32_t _pitch = 0;
 
+// mapping the framebuffer is slow and nothing draws during boot, so it is deferred until first use
+INITCALL(framebuffer, Framebuffer::init, Initcall::Mode::DEFERRED);
+
+/**
+ * @brief Initialize the framebuffer if it has not been
+ *
+ */
+static inline void __ensure_init(void) {
+	if (_addr == nullptr) {
+		Initcall::require("framebuffer");
+	}
+}
+
 void Framebuffer::init(void) {
 	Debug::log("Initializing framebuffer...");
 
@@ -58,17 +72,21 @@ void Framebuffer::init(void) {
 }
 
 int Framebuffer::width(void) {
+	__ensure_init();
 	return _width;
 }
 
 int Framebuffer::height(void) {
+	__ensure_init();
 	return _height;
 }
 
 int Framebuffer::pitch(void) {
+	__ensure_init();
 	return _pitch;
 }
 
 uint32_t *Framebuffer::addr(void) {
+	__ensure_init();
 	return _addr;
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 #include <kernel/arch/x86_64/gdt.h>
 #include <kernel/arch/x86_64/interrupts.h>
+#include <kernel/arch/x86_64/tss.h>
 #include <kernel/debug.h>
 #include <kernel/defines.h>
 #include <kernel/panic.h>
@@ -227,13 +228,13 @@ extern "C" INTERRUPT void default_isr(CPU::StackFrame *) {
 
 #pragma GCC pop_options
 
-static void __set_idt(uint8_t vector, void *isr, uint8_t flags) {
+static void __set_idt(uint8_t vector, void *isr, uint8_t flags, TSS::IST ist = TSS::IST::NONE) {
 	IDTEntry *entry = &idt[vector];
 	memset(entry, 0, sizeof(IDTEntry));
 
 	entry->offset_low = reinterpret_cast<uintptr_t>(isr) & 0xFFFF;
 	entry->selector = GDT_KCODE;
-	entry->ist = 0;
+	entry->ist = static_cast<uint8_t>(ist);
 	reinterpret_cast<uint8_t *>(entry)[5] = flags & 0xEF;
 	entry->offset_mid = (reinterpret_cast<uintptr_t>(isr) >> 16) & 0xFFFF;
 	entry->offset_high = (reinterpret_cast<uintptr_t>(isr) >> 32) & 0xFFFFFFFF;
@@ -255,12 +256,12 @@ void Interrupts::init(void) {
 	Debug::log("Installing exception handlers...");
 	__set_idt(0, reinterpret_cast<void *>(division_error), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(1, reinterpret_cast<void *>(debug), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
-	__set_idt(2, reinterpret_cast<void *>(non_maskable), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
+	__set_idt(2, reinterpret_cast<void *>(non_maskable), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT), TSS::IST::NMI);
 	__set_idt(3, reinterpret_cast<void *>(breakpoint), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(4, reinterpret_cast<void *>(overflow), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(6, reinterpret_cast<void *>(invalid_opcode), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(7, reinterpret_cast<void *>(device_not_available), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
-	__set_idt(8, reinterpret_cast<void *>(double_fault), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
+	__set_idt(8, reinterpret_cast<void *>(double_fault), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT), TSS::IST::DOUBLE_FAULT);
 	__set_idt(10, reinterpret_cast<void *>(invalid_tss), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(11, reinterpret_cast<void *>(segment_not_present), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(12, reinterpret_cast<void *>(stack_segment_fault), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
@@ -268,7 +269,7 @@ void Interrupts::init(void) {
 	__set_idt(14, reinterpret_cast<void *>(page_fault), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(16, reinterpret_cast<void *>(fpu_floating_point_error), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(17, reinterpret_cast<void *>(alignment_check), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
-	__set_idt(18, reinterpret_cast<void *>(machine_check), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
+	__set_idt(18, reinterpret_cast<void *>(machine_check), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT), TSS::IST::MACHINE_CHECK);
 	__set_idt(19, reinterpret_cast<void *>(simd_floating_point_error), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(20, reinterpret_cast<void *>(virtualization_error), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
 	__set_idt(21, reinterpret_cast<void *>(control_protection_exception), (GATE_TYPE_TRAP | DPL_KERNEL | PRESENT));
@@ -286,7 +287,7 @@ void Interrupts::init(void) {
 	Debug::log_ok("IDT initialized");
 }
 
-bool Interrupts::set_isr(uint8_t vector, void (*handler)(CPU::StackFrame *frame)) {
+bool Interrupts::set_isr(uint8_t vector, void (*handler)(CPU::StackFrame *frame), bool user) {
 	if (vector < 32) {
 		Debug::log_failure("Cannot set ISR for reserved vector %#x", vector);
 		return false;
@@ -300,7 +301,7 @@ bool Interrupts::set_isr(uint8_t vector, void (*handler)(CPU::StackFrame *frame)
 		return false;
 	}
 
-	__set_idt(vector, reinterpret_cast<void *>(handler), (GATE_TYPE_INTERRUPT | DPL_KERNEL | PRESENT));
+	__set_idt(vector, reinterpret_cast<void *>(handler), (GATE_TYPE_INTERRUPT | (user ? DPL_USER : DPL_KERNEL) | PRESENT));
 	return true;
 }
 
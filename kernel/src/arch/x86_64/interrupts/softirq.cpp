@@ -0,0 +1,242 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-12
+ * @brief Deferred interrupt processing (bottom halves) and threaded IRQ handlers
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cassert>
+
+#include <atomic>
+
+#include <kernel/arch/x86_64/interrupts.h>
+#include <kernel/arch/x86_64/interrupts/guard.h>
+#include <kernel/arch/x86_64/interrupts/pic.h>
+#include <kernel/arch/x86_64/interrupts/softirq.h>
+#include <kernel/arch/x86_64/scheduler.h>
+#include <kernel/debug.h>
+
+#define INTERRUPT __attribute__((interrupt))
+#define IRQ_BASE 32
+#define IRQ_COUNT 16
+#define MAX_RESTARTS 8
+
+/**
+ * @brief Per-CPU softirq state
+ *
+ */
+struct SoftIRQState {
+	std::atomic<uint32_t> pending;
+	bool active;
+	// SSE state of the interrupted code while softirqs run on IRQ exit, see irq_exit()
+	alignas(16) uint8_t fpu_state[512];
+};
+
+// TODO one per CPU once SMP is supported
+static SoftIRQState cpu_state[1];
+
+static void (*handlers[SoftIRQ::MAX_SOFTIRQS])(void);
+static Scheduler::Thread *ksoftirqd = nullptr;
+
+static void (*irq_handlers[IRQ_COUNT])(void);
+// accessed with __atomic builtins, std::atomic is always inlined which the IRQ stubs cannot do
+static uint16_t irq_pending;
+
+/**
+ * @brief Get the softirq state for the current CPU
+ *
+ * @return The softirq state for the current CPU
+ */
+static inline SoftIRQState &__this_cpu(void) {
+	return cpu_state[0];
+}
+
+/**
+ * @brief Run pending softirqs in batches
+ *
+ * @return true if all pending softirqs were processed, false if the restart limit was reached
+ *
+ * @note Must be called with interrupts disabled, interrupts are enabled while handlers run
+ */
+static bool __do_softirq(void) {
+	auto &state = __this_cpu();
+	state.active = true;
+
+	size_t restarts = MAX_RESTARTS;
+	uint32_t pending;
+
+	while ((pending = state.pending.exchange(0)) != 0) {
+		Interrupts::enable();
+		while (pending) {
+			auto type = __builtin_ctz(pending);
+			pending &= pending - 1;
+			if (handlers[type]) {
+				handlers[type]();
+			}
+		}
+		Interrupts::disable();
+
+		if (--restarts == 0) {
+			break;
+		}
+	}
+
+	state.active = false;
+	return state.pending.load() == 0;
+}
+
+/**
+ * @brief Entry point of the ksoftirqd thread, processes softirqs that could not be handled on IRQ exit
+ *
+ */
+static void __ksoftirqd(void) {
+	while (true) {
+		{
+			Interrupts::Guard guard;
+			if (!SoftIRQ::is_pending()) {
+				Scheduler::block();
+				continue;
+			}
+			__do_softirq();
+		}
+		Scheduler::yield();
+	}
+}
+
+/**
+ * @brief Softirq handler that runs the threaded handlers for all pending IRQs
+ *
+ */
+static void __irq_softirq(void) {
+	uint16_t pending = __atomic_exchange_n(&irq_pending, 0, __ATOMIC_ACQ_REL);
+	while (pending) {
+		auto irq = __builtin_ctz(pending);
+		pending &= pending - 1;
+		if (irq_handlers[irq]) {
+			irq_handlers[irq]();
+			PIC::clear_mask(irq);
+		}
+	}
+}
+
+// Nothing on the hard IRQ path before the fxsave64 in irq_exit may touch the vector registers, they still
+// belong to the interrupted code. This region is compiled without them, and the out-of-line helpers it calls
+// (PIC, SoftIRQ::raise, Interrupts::Guard) only use general registers. ALWAYS_INLINE functions such as
+// std::atomic members are not used here, GCC refuses to inline them across the target change.
+#pragma GCC push_options
+#pragma GCC target("general-regs-only")
+
+/**
+ * @brief Hard IRQ stub, masks and acknowledges the IRQ then defers the handler to softirq context
+ *
+ * @tparam irq The IRQ line
+ */
+template <uint8_t irq>
+static INTERRUPT void __irq_stub(CPU::StackFrame *) {
+	PIC::set_mask(irq);
+	PIC::eoi(irq);
+	__atomic_fetch_or(&irq_pending, static_cast<uint16_t>(1u << irq), __ATOMIC_RELAXED);
+	SoftIRQ::raise(SoftIRQ::Type::IRQ);
+	SoftIRQ::irq_exit();
+}
+
+void SoftIRQ::irq_exit(void) {
+	Interrupts::Guard guard;
+
+	// nested interrupts are picked up by the outer __do_softirq loop
+	if (in_softirq() || !is_pending()) {
+		return;
+	}
+
+	// softirq handlers are compiled with SSE enabled, save the interrupted code's registers around them,
+	// nested irq_exit calls return above so one buffer per CPU is enough
+	auto &state = __this_cpu();
+	asm volatile("fxsave64 %0" : "=m"(state.fpu_state));
+	bool done = __do_softirq();
+	asm volatile("fxrstor64 %0" ::"m"(state.fpu_state));
+
+	if (!done && ksoftirqd) {
+		Scheduler::wake(ksoftirqd);
+	}
+}
+
+#pragma GCC pop_options
+
+static void (*const irq_stubs[IRQ_COUNT])(CPU::StackFrame *) = {
+	__irq_stub<0>, __irq_stub<1>, __irq_stub<2>, __irq_stub<3>,
+	__irq_stub<4>, __irq_stub<5>, __irq_stub<6>, __irq_stub<7>,
+	__irq_stub<8>, __irq_stub<9>, __irq_stub<10>, __irq_stub<11>,
+	__irq_stub<12>, __irq_stub<13>, __irq_stub<14>, __irq_stub<15>};
+
+void SoftIRQ::init(void) {
+	Debug::log("Initializing softirqs...");
+
+	set_handler(Type::IRQ, __irq_softirq);
+	ksoftirqd = Scheduler::create_thread(__ksoftirqd);
+
+	Debug::log_ok("Softirqs initialized");
+}
+
+bool SoftIRQ::set_handler(Type type, void (*handler)(void)) {
+	auto index = static_cast<size_t>(type);
+	if (index >= MAX_SOFTIRQS) {
+		Debug::log_failure("Cannot set handler for invalid softirq %zu", index);
+		return false;
+	}
+	if (handlers[index] != nullptr) {
+		Debug::log_failure("Softirq %zu handler already set", index);
+		return false;
+	}
+
+	handlers[index] = handler;
+	return true;
+}
+
+void SoftIRQ::raise(Type type) {
+	__this_cpu().pending.fetch_or(1u << static_cast<uint8_t>(type), std::memory_order::relaxed);
+}
+
+bool SoftIRQ::is_pending(void) {
+	return __this_cpu().pending.load(std::memory_order::relaxed) != 0;
+}
+
+bool SoftIRQ::in_softirq(void) {
+	return __this_cpu().active;
+}
+
+bool SoftIRQ::request_irq(uint8_t irq, void (*handler)(void)) {
+	if (irq >= IRQ_COUNT) {
+		Debug::log_failure("Cannot request invalid IRQ: %#.2x", irq);
+		return false;
+	}
+	if (handler == nullptr) {
+		Debug::log_failure("Cannot request IRQ %u with null handler, use free_irq() instead", irq);
+		return false;
+	}
+
+	Interrupts::Guard guard;
+	if (!Interrupts::set_isr(IRQ_BASE + irq, irq_stubs[irq])) {
+		return false;
+	}
+
+	irq_handlers[irq] = handler;
+	PIC::clear_mask(irq);
+	return true;
+}
+
+bool SoftIRQ::free_irq(uint8_t irq) {
+	if (irq >= IRQ_COUNT) {
+		Debug::log_failure("Cannot free invalid IRQ: %#.2x", irq);
+		return false;
+	}
+
+	Interrupts::Guard guard;
+	PIC::set_mask(irq);
+	irq_handlers[irq] = nullptr;
+	return Interrupts::clear_isr(IRQ_BASE + irq);
+}
\ No newline at end of file
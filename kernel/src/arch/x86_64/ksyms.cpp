@@ -19,12 +19,16 @@
 #include <kernel/arch/x86_64/memory/paging.h>
 #include <kernel/arch/x86_64/multiboot2.h>
 #include <kernel/debug.h>
+#include <kernel/initcall.h>
 
 static ELF::SectionHeader const *symtab = nullptr;
 static char *strtab = nullptr;
 
+// only needed for stack traces, so indexed on first use rather than during boot
+INITCALL(ksyms, KSyms::init, Initcall::Mode::DEFERRED);
+
 std::pair<std::string_view, uintptr_t> KSyms::get_symbol(void *addr) {
-	if (!is_available()) {
+	if (!Initcall::require("ksyms") || strtab == nullptr) {
 		return {nullptr, 0};
 	}
 
@@ -81,5 +85,6 @@ void KSyms::init(void) {
 }
 
 bool KSyms::is_available(void) {
-	return strtab != nullptr;
+	// never runs the initcall, a panic may be holding what it needs
+	return Initcall::is_done("ksyms") && strtab != nullptr;
 }
\ No newline at end of file
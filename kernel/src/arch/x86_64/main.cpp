@@ -19,20 +19,24 @@
 #include <new>
 #include <span>
 
+#include <kernel/arch/console.h>
 #include <kernel/arch/framebuffer.h>
-#include <kernel/arch/ksyms.h>
 #include <kernel/arch/memory.h>
 #include <kernel/arch/x86_64/boot/entry.h>
 #include <kernel/arch/x86_64/cpu.h>
 #include <kernel/arch/x86_64/interrupts.h>
 #include <kernel/arch/x86_64/interrupts/pic.h>
+#include <kernel/arch/x86_64/interrupts/softirq.h>
 #include <kernel/arch/x86_64/memory/paging.h>
 #include <kernel/arch/x86_64/multiboot2.h>
 #include <kernel/arch/x86_64/scheduler.h>
-#include <kernel/arch/x86_64/time/rtc.h>
+#include <kernel/arch/x86_64/syscall.h>
 #include <kernel/arch/x86_64/tss.h>
 #include <kernel/debug.h>
+#include <kernel/initcall.h>
+#include <kernel/log.h>
 #include <kernel/panic.h>
+#include <kernel/profiler.h>
 #include <kernel/version.h>
 
 typedef void (*Constructor)(void);
@@ -40,6 +44,8 @@ typedef void (*Constructor)(void);
 extern "C" Constructor __kernel_ctors_start;
 extern "C" Constructor __kernel_ctors_end;
 
+extern "C" void __string_init(void);
+
 namespace Kernel {
 	/**
 	 * @brief Late initialization function
@@ -48,9 +54,10 @@ namespace Kernel {
 	[[noreturn]] void late_init(void) {
 		Debug::log("Starting late initialization...");
 
-		namespace FB = Graphics::Framebuffer;
-		FB::init();
+		Profiler::measure("Initcall::run", Initcall::run);
 
+		// first use of the framebuffer, which runs its deferred initcall
+		namespace FB = Graphics::Framebuffer;
 		for (int y = 0; y < FB::height(); y++) {
 			uint32_t *pixel = FB::addr() + (y * FB::pitch() / 4);
 			for (int x = 0; x < FB::width(); x++) {
@@ -62,6 +69,8 @@ namespace Kernel {
 			}
 		}
 
+		Profiler::dump();
+
 		Debug::log_warning("Entering idle loop");
 		while (true) {
 			Scheduler::yield();
@@ -85,7 +94,7 @@ namespace Kernel {
 				   __kernel_build_date,
 				   __kernel_build_time);
 
-		Multiboot2::init(magic, addr);
+		Profiler::measure("Multiboot2::init", Multiboot2::init, magic, addr);
 
 		auto bootloader_name = static_cast<Multiboot2::StringTag const *>(Multiboot2::get_entry(Multiboot2::BootInfoType::BOOTLOADER_NAME))->string;
 		auto boot_cmd_line = static_cast<Multiboot2::StringTag const *>(Multiboot2::get_entry(Multiboot2::BootInfoType::BOOT_CMD_LINE))->string;
@@ -123,26 +132,28 @@ namespace Kernel {
 		Debug::log_info("GRUB options: %s", boot_cmd_line);
 		Debug::log_info("CPU: %s (%s)", cpu_brand, cpu_vendor);
 
-		Interrupts::init();
-		TSS::init();
-		KSyms::init();
-		PIC::init();
-		Memory::init();
-
-		Debug::log("Initializing global constructors...");
-		const std::span ctors(&__kernel_ctors_start, &__kernel_ctors_end);
-		for (auto ctor : ctors) {
-			std::invoke(ctor);
+		Profiler::measure("TSS::init", TSS::init);
+		Profiler::measure("Interrupts::init", Interrupts::init);
+		Profiler::measure("PIC::init", PIC::init);
+		Profiler::measure("Syscall::init", Syscall::init);
+		Profiler::measure("Memory::init", Memory::init);
+
+		{
+			Profiler::Scope scope("Global constructors");
+			Debug::log("Initializing global constructors...");
+			const std::span ctors(&__kernel_ctors_start, &__kernel_ctors_end);
+			for (auto ctor : ctors) {
+				std::invoke(ctor);
+			}
+			Debug::log_ok("Initialized %zu global constructors", ctors.size());
 		}
-		Debug::log_ok("Initialized %zu global constructors", ctors.size());
-
-		Time::RTC::init();
 
 		// x86_64 requires SSE and SSE2
 		assert(CPU::has_feature(CPU::Feature::SSE));
 		assert(CPU::has_feature(CPU::Feature::SSE2));
 
 		Debug::log("Enabling SSE...");
+		auto sse_phase = Profiler::begin("SSE");
 		asm volatile("mov rax, cr0;"
 					 "and ax, 0xfffb;"
 					 "or ax, 0x2;"
@@ -150,9 +161,18 @@ namespace Kernel {
 					 "mov rax, cr4;"
 					 "or ax, 0x600;"
 					 "mov cr4, rax" ::: "rax");
+		Profiler::end(sse_phase);
 		Debug::log_ok("SSE enabled");
 
-		Scheduler::init();
+		Debug::log_info("ERMS: %s, FSRM: %s",
+						CPU::has_feature(CPU::Feature::ERMS) ? "yes" : "no",
+						CPU::has_feature(CPU::Feature::FSRM) ? "yes" : "no");
+		Profiler::measure("String functions", __string_init);
+
+		Profiler::measure("Scheduler::init", Scheduler::init);
+		Profiler::measure("SoftIRQ::init", SoftIRQ::init);
+		Profiler::measure("Console::init", Console::init);
+		Profiler::measure("Log::init", Log::init);
 		Scheduler::create_thread(late_init);
 		Scheduler::start();
 	}
@@ -25,6 +25,7 @@
 #include <kernel/arch/x86_64/multiboot2.h>
 #include <kernel/debug.h>
 #include <kernel/defines.h>
+#include <kernel/profiler.h>
 
 #define KERNEL_HEAP_SIZE (64 * MiB)
 
@@ -50,8 +51,8 @@ void Memory::init(void) {
 		}
 	}
 
-	Paging::init();
-	PhysicalMemory::init();
+	Profiler::measure("Paging::init", Paging::init);
+	Profiler::measure("PhysicalMemory::init", PhysicalMemory::init);
 
 	Debug::log_ok("Memory initialized");
 }
@@ -90,6 +91,21 @@ void Memory::deallocate(void *ptr, size_t size, size_t alignment) {
 	Debug::log_warning("Memory::deallocate() is not yet implemented");
 }
 
+bool Memory::expand(void *ptr, size_t size, size_t new_size) {
+	if (!ptr || new_size <= size) {
+		return ptr != nullptr;
+	}
+
+	// only the most recent allocation can grow, it is the one ending at the top of the heap
+	auto end = static_cast<uint8_t *>(ptr) + size;
+	if (end != heap_ptr || new_size - size > static_cast<size_t>(heap + KERNEL_HEAP_SIZE - heap_ptr)) {
+		return false;
+	}
+
+	heap_ptr += new_size - size;
+	return true;
+}
+
 std::vector<Memory::MemoryRegion> const &Memory::regions(void) {
 	return memory_regions;
 }
\ No newline at end of file
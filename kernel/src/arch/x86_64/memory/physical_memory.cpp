@@ -11,7 +11,7 @@
  */
 
 #include <algorithm>
-#include <bitfield>
+#include <bitmap>
 
 #include <kernel/arch/x86_64/memory/paging.h>
 #include <kernel/arch/x86_64/memory/physical_memory.h>
@@ -24,7 +24,7 @@ using namespace Memory;
 
 extern char __kernel_end;
 
-static std::vector<std::vector<std::bitfield<PhysicalMemory::Zone>>> page_bitmaps;
+static std::vector<std::bitmap<PhysicalMemory::Zone>> page_bitmaps;
 static std::vector<size_t> allocated_pages;
 static size_t total_memory = 0;
 
@@ -55,18 +55,12 @@ void PhysicalMemory::init(void) {
 		allocated_pages.emplace_back(0);
 
 		if (final_page >= region.upper) {
-			page_bitmaps.back().resize(region.zones(), ~Zone(0));
+			page_bitmaps.back().resize(region.zones() * ZONE_SIZE, true);
 			allocated_pages.back() = region.pages();
 		} else if (region.contains(final_page)) {
 			allocated_pages.back() = (final_page - region.lower) / Paging::PAGE_SIZE;
-			auto zones = allocated_pages.back() / ZONE_SIZE;
-			auto bits = allocated_pages.back() % ZONE_SIZE;
-
-			page_bitmaps.back().reserve(zones + 1);
-			page_bitmaps.back().resize(zones, ~Zone(0));
-			if (bits != 0) {
-				page_bitmaps.back().emplace_back(bits, true);
-			}
+			page_bitmaps.back().reserve(allocated_pages.back() + ZONE_SIZE);
+			page_bitmaps.back().resize(allocated_pages.back(), true);
 		}
 	}
 
@@ -84,28 +78,17 @@ std::optional<PhysAddr> PhysicalMemory::alloc(void) {
 			continue;
 		}
 
-		for (size_t zone = 0; zone < bitmap.size(); zone++) {
-			if (bitmap[zone].full()) {
-				continue;
-			}
-
-			for (size_t bit = 0; bit < ZONE_SIZE; bit++) {
-				if (!bitmap[zone][bit]) {
-					bitmap[zone].set(bit, true);
-					allocated++;
-
-					auto addr = region.lower + (zone * ZONE_SIZE + bit) * Paging::PAGE_SIZE;
-#ifdef DEBUG
-					assert(region.contains(addr));
-#endif
-					return addr;
-				}
-			}
+		auto page = bitmap.find_first_unset();
+		if (page == bitmap.npos) {
+			// pages past the end of the bitmap are free, grow it a zone at a time
+			page = bitmap.size();
+			bitmap.resize((page / ZONE_SIZE + 1) * ZONE_SIZE);
 		}
 
-		bitmap.emplace_back(1);
+		bitmap.set(page, true);
 		allocated++;
-		auto addr = region.lower + (bitmap.size() - 1) * ZONE_SIZE * Paging::PAGE_SIZE;
+
+		auto addr = region.lower + page * Paging::PAGE_SIZE;
 #ifdef DEBUG
 		assert(region.contains(addr));
 #endif
@@ -123,10 +106,9 @@ void PhysicalMemory::free(PhysAddr addr) {
 			continue;
 		}
 
-		auto zone = (addr - region.lower) / (ZONE_SIZE * Paging::PAGE_SIZE);
-		auto bit = (addr - region.lower) / Paging::PAGE_SIZE % ZONE_SIZE;
+		auto page = (addr - region.lower) / Paging::PAGE_SIZE;
 
-		page_bitmaps[idx][zone].set(bit, false);
+		page_bitmaps[idx].set(page, false);
 		allocated_pages[idx]--;
 		return;
 	}
@@ -13,17 +13,18 @@
 #include <cassert>
 #include <cstring>
 #include <functional>
-#include <iterator>
-#include <list>
-#include <queue>
+#include <intrusive_list>
+#include <intrusive_rbtree>
 
 #include <kernel/arch/x86_64/cpu.h>
 #include <kernel/arch/x86_64/gdt.h>
 #include <kernel/arch/x86_64/interrupts.h>
+#include <kernel/arch/x86_64/interrupts/guard.h>
 #include <kernel/arch/x86_64/interrupts/pic.h>
 #include <kernel/arch/x86_64/memory/paging.h>
 #include <kernel/arch/x86_64/memory/physical_memory.h>
 #include <kernel/arch/x86_64/scheduler.h>
+#include <kernel/arch/x86_64/syscall.h>
 #include <kernel/debug.h>
 
 #define IRQ_PIT_TIMER 32
@@ -32,13 +33,23 @@
 extern "C" void scheduler_preempt(CPU::StackFrame *);
 extern "C" void scheduler_yield(CPU::StackFrame *);
 
-static std::list<Scheduler::Thread> threads;
-static std::list<Scheduler::Thread>::iterator current_thread;
+/**
+ * @brief Orders sleeping threads by the tick they wake up at
+ *
+ */
+struct WakeOrder {
+	bool operator()(const Scheduler::Thread &a, const Scheduler::Thread &b) const {
+		return a.sleep_until < b.sleep_until;
+	}
+};
 
-auto cmp = [](Scheduler::Thread *a, Scheduler::Thread *b) { return a->sleep_until > b->sleep_until; };
-static std::priority_queue<Scheduler::Thread *, std::vector<Scheduler::Thread *>, decltype(cmp)> sleep_queue(cmp);
+static Scheduler::Thread boot_thread;
+static std::intrusive_list<Scheduler::Thread, &Scheduler::Thread::list_hook> threads;
+static Scheduler::Thread *current_thread = nullptr;
+static std::intrusive_rbtree<Scheduler::Thread, &Scheduler::Thread::sleep_hook, WakeOrder> sleep_queue;
 
 static uint64_t current_tick = 0;
+static bool running = false;
 
 namespace Scheduler {
 	/**
@@ -48,26 +59,28 @@ namespace Scheduler {
 	 */
 	static Thread &schedule() {
 		while (!sleep_queue.empty()) {
-			auto &thread = sleep_queue.top();
-			if (thread->sleep_until > current_tick) {
+			auto &thread = *sleep_queue.begin();
+			if (thread.sleep_until > current_tick) {
 				break;
 			}
-			thread->status = Thread::Status::WAITING;
-			sleep_queue.pop();
+			thread.status = Thread::Status::WAITING;
+			sleep_queue.erase(thread);
 		}
 
-		auto last_thread = current_thread;
+		auto last_thread = threads.iterator_to(*current_thread);
+		auto next_thread = last_thread;
 
 		do {
-			std::advance(current_thread, 1);
-			if (current_thread == threads.end()) {
-				current_thread = threads.begin();
+			++next_thread;
+			if (next_thread == threads.end()) {
+				next_thread = threads.begin();
 			}
-			if (current_thread == last_thread) {
+			if (next_thread == last_thread) {
 				break;
 			}
-		} while (current_thread->status != Thread::Status::WAITING);
+		} while (next_thread->status != Thread::Status::WAITING);
 
+		current_thread = &*next_thread;
 		return *current_thread;
 	}
 
@@ -89,9 +102,9 @@ void Scheduler::init(void) {
 	Interrupts::set_isr(IRQ_SCHED_YIELD, scheduler_yield);
 	// TODO change PIT IRQ frequency
 
-	threads.emplace_back();
-	threads.back().id = Thread::alloc_id();
-	threads.back().status = Thread::Status::RUNNING;
+	boot_thread.id = Thread::alloc_id();
+	boot_thread.status = Thread::Status::RUNNING;
+	threads.push_back(boot_thread);
 
 	Debug::log_ok("Scheduler initialized");
 }
@@ -99,7 +112,8 @@ void Scheduler::init(void) {
 void Scheduler::start(void) {
 	Debug::log("Starting scheduler...");
 	assert(!threads.empty());
-	current_thread = threads.begin();
+	current_thread = &threads.front();
+	running = true;
 
 	PIC::clear_mask(0);
 	Interrupts::enable();
@@ -107,10 +121,15 @@ void Scheduler::start(void) {
 	while (true) {
 		for (auto thread = threads.begin(); thread != threads.end();) {
 			if (thread->status == Thread::Status::STOPPED) {
-				auto stack = Memory::Paging::translate(thread->stack_base);
+				auto &stopped = *thread;
+				{
+					Interrupts::Guard guard;
+					thread = threads.erase(thread);
+				}
+				auto stack = Memory::Paging::translate(stopped.stack_base);
 				assert(stack.has_value());
 				Memory::PhysicalMemory::free(stack.value());
-				thread = threads.erase(thread);
+				delete &stopped;
 			} else {
 				++thread;
 			}
@@ -121,30 +140,35 @@ void Scheduler::start(void) {
 }
 
 Scheduler::Thread *Scheduler::create_thread(void (*entry)(void)) {
-	Thread thread{};
+	auto thread = new Thread{};
 
 	auto stack = Memory::PhysicalMemory::alloc();
 	assert(stack.has_value());
 
-	thread.id = Thread::alloc_id();
-	thread.status = Thread::Status::WAITING;
-	thread.stack_base = Memory::Paging::to_kernel(stack.value());
-
-	thread.regs.rdi = reinterpret_cast<uint64_t>(entry);
-	thread.regs.frame.rip = reinterpret_cast<uint64_t>(thread_wrapper);
-	thread.regs.frame.rflags = RFLAGS_RESERVED | RFLAGS_INTERRUPT_ENABLE;
-	thread.regs.frame.cs = GDT_KCODE;
-	thread.regs.frame.ss = GDT_KDATA;
-	thread.regs.frame.rsp = thread.stack_base + Memory::Paging::PAGE_SIZE;
-
-	threads.push_back(thread);
-	return &threads.back();
+	thread->id = Thread::alloc_id();
+	thread->status = Thread::Status::WAITING;
+	thread->stack_base = Memory::Paging::to_kernel(stack.value());
+
+	thread->regs.rdi = reinterpret_cast<uint64_t>(entry);
+	thread->regs.frame.rip = reinterpret_cast<uint64_t>(thread_wrapper);
+	thread->regs.frame.rflags = RFLAGS_RESERVED | RFLAGS_INTERRUPT_ENABLE;
+	thread->regs.frame.cs = GDT_KCODE;
+	thread->regs.frame.ss = GDT_KDATA;
+	thread->regs.frame.rsp = thread->stack_base + Memory::Paging::PAGE_SIZE;
+
+	// the scheduler walks the list from the timer interrupt
+	Interrupts::Guard guard;
+	threads.push_back(*thread);
+	return thread;
 }
 
 void Scheduler::sleep_until(uint64_t tick) {
-	current_thread->sleep_until = tick;
-	current_thread->status = Thread::Status::SLEEPING;
-	sleep_queue.push(&*current_thread);
+	{
+		Interrupts::Guard guard;
+		current_thread->sleep_until = tick;
+		current_thread->status = Thread::Status::SLEEPING;
+		sleep_queue.insert(*current_thread);
+	}
 	yield();
 }
 
@@ -152,12 +176,29 @@ void Scheduler::sleep_for(uint64_t ticks) {
 	sleep_until(current_tick + ticks);
 }
 
+void Scheduler::block(void) {
+	current_thread->status = Thread::Status::BLOCKED;
+	yield();
+}
+
+bool Scheduler::wake(Thread *thread) {
+	assert(thread);
+	if (thread->status != Thread::Status::BLOCKED) {
+		return false;
+	}
+	thread->status = Thread::Status::WAITING;
+	return true;
+}
+
 void Scheduler::yield(void) {
 	Interrupts::invoke<IRQ_SCHED_YIELD>();
 }
 
 const Scheduler::Thread *Scheduler::Thread::current(void) {
-	return &*current_thread;
+	if (!running) {
+		return nullptr;
+	}
+	return current_thread;
 }
 
 #pragma GCC push_options
@@ -195,6 +236,11 @@ extern "C" void __attribute__((no_caller_saved_registers)) scheduler_swap(CPU::S
 	// restore CPU state registers
 	memcpy(state, &next.regs, sizeof(CPU::State));
 	next.status = Thread::Status::RUNNING;
+
+	// the boot thread has no stack_base and is never in user mode
+	if (next.stack_base) {
+		Syscall::set_kernel_stack(next.stack_base + Memory::Paging::PAGE_SIZE);
+	}
 }
 
 /**
@@ -0,0 +1,104 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-13
+ * @brief System call entry and dispatch
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cerrno>
+#include <cstddef>
+
+#include <kernel/arch/x86_64/cpu.h>
+#include <kernel/arch/x86_64/gdt.h>
+#include <kernel/arch/x86_64/interrupts.h>
+#include <kernel/arch/x86_64/syscall.h>
+#include <kernel/arch/x86_64/tss.h>
+#include <kernel/debug.h>
+
+extern "C" void syscall_entry(void);
+extern "C" void syscall_interrupt(CPU::StackFrame *);
+
+/**
+ * @brief Per-CPU data reachable through the GS segment while in the kernel
+ *
+ * @note The layout of this structure is relied upon by asm/syscall.asm
+ */
+struct PerCPU {
+	uint64_t kernel_rsp;
+	uint64_t user_rsp;
+};
+
+// TODO one per CPU once SMP is supported
+static PerCPU per_cpu;
+
+static Syscall::Handler handlers[Syscall::MAX_SYSCALLS];
+
+/**
+ * @brief System call that does nothing, useful for measuring the cost of entry and exit
+ *
+ * @return Always 0
+ */
+static int64_t __sys_nop(Syscall::Frame *) {
+	return 0;
+}
+
+/**
+ * @brief Dispatch a system call to its handler
+ *
+ * @param frame The registers saved on entry
+ * @return The value to return to the caller
+ */
+extern "C" int64_t syscall_dispatch(Syscall::Frame *frame) {
+	if (frame->number >= Syscall::MAX_SYSCALLS || handlers[frame->number] == nullptr) {
+		return -ENOSYS;
+	}
+	return handlers[frame->number](frame);
+}
+
+void Syscall::init(void) {
+	Debug::log("Initializing system calls...");
+
+	// SYSCALL is always available in long mode on Intel and AMD processors
+	CPU::set_msr(IA32_EFER_MSR, CPU::get_msr(IA32_EFER_MSR) | IA32_EFER_SCE);
+
+	// SYSCALL loads CS = STAR[47:32] and SS = STAR[47:32] + 8
+	// SYSRET loads SS = STAR[63:48] + 8 and CS = STAR[63:48] + 16
+	uint64_t star = (static_cast<uint64_t>(GDT_UDATA - 8) << 48) | (static_cast<uint64_t>(GDT_KCODE) << 32);
+	CPU::set_msr(IA32_STAR_MSR, star);
+	CPU::set_msr(IA32_LSTAR_MSR, reinterpret_cast<uint64_t>(syscall_entry));
+	// mask interrupts, direction, trap and alignment check on entry
+	CPU::set_msr(IA32_FMASK_MSR, RFLAGS_INTERRUPT_ENABLE | RFLAGS_DIRECTION | RFLAGS_TRAP | RFLAGS_ALIGNMENT_CHECK);
+
+	// the kernel does not use GS itself, so the per-CPU data is only swapped in by swapgs on entry
+	CPU::set_msr(IA32_KERNEL_GS_BASE_MSR, reinterpret_cast<uint64_t>(&per_cpu));
+	set_kernel_stack(reinterpret_cast<uint64_t>(__builtin_frame_address(0)));
+
+	Interrupts::set_isr(VECTOR, syscall_interrupt, true);
+	set_handler(static_cast<size_t>(Number::NOP), __sys_nop);
+
+	Debug::log_ok("System calls initialized");
+}
+
+bool Syscall::set_handler(size_t number, Handler handler) {
+	if (number >= MAX_SYSCALLS) {
+		Debug::log_failure("Cannot set handler for invalid syscall %zu", number);
+		return false;
+	}
+	if (handlers[number] != nullptr) {
+		Debug::log_failure("Syscall %zu handler already set", number);
+		return false;
+	}
+
+	handlers[number] = handler;
+	return true;
+}
+
+void Syscall::set_kernel_stack(uint64_t rsp) {
+	per_cpu.kernel_rsp = rsp;
+	TSS::set_kernel_stack(rsp);
+}
\ No newline at end of file
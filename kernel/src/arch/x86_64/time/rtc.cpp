@@ -13,6 +13,7 @@
 #include <kernel/arch/x86_64/cmos.h>
 #include <kernel/arch/x86_64/time/rtc.h>
 #include <kernel/debug.h>
+#include <kernel/initcall.h>
 
 #define RTC_SECONDS_REG 0x00
 #define RTC_MINUTES_REG 0x02
@@ -31,6 +32,8 @@ using namespace Time;
 
 static DateTime _boot_time;
 
+INITCALL(rtc, RTC::init, Initcall::Mode::PARALLEL);
+
 /**
  * @brief Convert a Binary Coded Decimal number to a binary number
  *
@@ -109,5 +112,6 @@ DateTime RTC::now(void) {
 }
 
 DateTime RTC::boot_time(void) {
+	Initcall::require("rtc");
 	return _boot_time;
 }
\ No newline at end of file
@@ -41,9 +41,14 @@ struct TSSDescriptor {
 	unsigned : 32;
 } PACKED;
 
+#define IST_STACKS 3
+
 static TSSEntry tss;
 extern char gdt[];
 
+// TODO one TSS and set of IST stacks per CPU once SMP is supported
+static ALIGNED(16) uint8_t ist_stacks[IST_STACKS][TSS::IST_STACK_SIZE];
+
 void TSS::init(void) {
 	Debug::log("Initializing TSS...");
 
@@ -52,6 +57,12 @@ void TSS::init(void) {
 	tss.rsp[0] = reinterpret_cast<uint64_t>(__builtin_frame_address(0));
 	tss.iomap_base = sizeof(TSSEntry);
 
+	Debug::log("Configuring interrupt stack table...");
+	for (size_t i = 0; i < IST_STACKS; i++) {
+		// ist[0] holds IST1, stacks grow down so point to the top
+		tss.ist[i] = reinterpret_cast<uint64_t>(&ist_stacks[i][TSS::IST_STACK_SIZE]);
+	}
+
 	Debug::log("Configuring TSS descriptor...");
 	TSSDescriptor *tss_descriptor = reinterpret_cast<TSSDescriptor *>(&gdt[GDT_TSS]);
 	memset(tss_descriptor, 0, sizeof(TSSDescriptor));
@@ -70,4 +81,8 @@ void TSS::init(void) {
 	asm volatile("ltr %0" ::"r"(GDT_TSS));
 
 	Debug::log_ok("TSS initialized");
+}
+
+void TSS::set_kernel_stack(uint64_t rsp) {
+	tss.rsp[0] = rsp;
 }
\ No newline at end of file
@@ -10,31 +10,46 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <kernel/arch/x86_64/cpu.h>
+#include <kernel/arch/x86_64/interrupts.h>
+#include <kernel/arch/x86_64/interrupts/guard.h>
+#include <kernel/arch/x86_64/interrupts/softirq.h>
 #include <kernel/arch/x86_64/io.h>
 #include <kernel/arch/x86_64/uart.h>
 
 // FIXME Get this decleration inside uart.h
 bool UART::portUsed_m[4];
+UART *UART::instances_m[4];
+
+// COM1/COM3 share IRQ 4 and COM2/COM4 share IRQ 3
+static bool irqRequested[2];
 
 uint16_t portToIndex(UART::UARTPort port) {
 	return ((port - 744) % 7) / 2;
 }
 
-UART::UART(UARTPort port) : port_m(port) {
-	// TODO
-	// IO::write<uint8_t>(port + 1, 0x00); // Disable all interupts
+static uint8_t portToIRQ(UART::UARTPort port) {
+	return (port == UART::COM1 || port == UART::COM3) ? 4 : 3;
+}
+
+UART::UART(UARTPort port) : port_m(port), interrupts_m(false), rx_m{}, tx_m{} {
+	// reprogramming the port (and clearing the FIFOs) would drop any bytes still being sent
+	while ((IO::read<uint8_t>(port + UART_OFFSET_LINE_STATUS) & UART_LSR_TX_IDLE) == 0) {
+		CPU::pause();
+	}
+	IO::write<uint8_t>(port + UART_OFFSET_INTERRUPT_ENABLE, 0x00); // Disable all interupts
 
 	setBaudRate(UART_MAX_BAUD_RATE);
 	setLineProtocol(UART_DATA_8_BITS | UART_PARITY_NONE | UART_STOP_1_BITS);
 
-	// TODO
-	// IO::write<uint8_t>(port + 2, 0xC7); // Enable FIFO, clear them, with 14-byte threshold
-	// IO::write<uint8_t>(port + 4, 0x0B); // IRQs enabled, RTS/DSR set
+	IO::write<uint8_t>(port + UART_OFFSET_FIFO_CONTROL, UART_FCR_ENABLE_14_BYTES); // Enable FIFO, clear them, with 14-byte threshold
+	IO::write<uint8_t>(port + UART_OFFSET_MODEM_CONTROL, UART_MCR_DTR_RTS_OUT2);	// IRQs enabled, RTS/DSR set
 
 	portUsed_m[portToIndex(port)] = true;
 }
 
 UART::~UART() {
+	disableInterrupts();
 	// TODO Unsetup ports?
 	portUsed_m[portToIndex(this->port_m)] = false;
 }
@@ -65,17 +80,155 @@ bool UART::setLineProtocol(uint8_t protocol) {
 }
 
 uint8_t UART::read() {
-	while ((IO::read<uint8_t>(this->port_m + 5) & 0x01) == 0) {
+	if (this->interrupts_m) {
+		uint8_t value;
+		while (read(&value, 1) == 0) {
+			CPU::pause();
+		}
+		return value;
+	}
+
+	while ((IO::read<uint8_t>(this->port_m + UART_OFFSET_LINE_STATUS) & UART_LSR_DATA_READY) == 0) {
 		// TODO Wait
 	}
-	return IO::read<uint8_t>(this->port_m);
+	return IO::read<uint8_t>(this->port_m + UART_OFFSET_DATA);
 }
 
 void UART::write(uint8_t value) {
-	while ((IO::read<uint8_t>(this->port_m + 5) & 0x20) == 0) {
-		// TODO Wait
+	write(std::span<const uint8_t>(&value, size_t{1}));
+}
+
+size_t UART::write(std::span<const uint8_t> data) {
+	// buffer only while the IRQ can actually drain the ring, otherwise output synchronously
+	if (this->interrupts_m && Interrupts::is_enabled() && !SoftIRQ::in_softirq()) {
+		size_t i = 0;
+		while (true) {
+			{
+				Interrupts::Guard guard;
+				i += this->tx_m.write(data.subspan(i));
+				// enabling the THR empty interrupt fires immediately if the transmitter is idle
+				IO::write<uint8_t>(this->port_m + UART_OFFSET_INTERRUPT_ENABLE, UART_IER_RX_AVAILABLE | UART_IER_TX_EMPTY);
+			}
+			if (i == data.size()) {
+				break;
+			}
+			CPU::pause();
+		}
+		return data.size();
+	}
+
+	// keep ordering with any output that is still buffered
+	flush();
+
+	// each LSR check covers a whole FIFO of bytes rather than a single byte
+	size_t i = 0;
+	while (i < data.size()) {
+		while ((IO::read<uint8_t>(this->port_m + UART_OFFSET_LINE_STATUS) & UART_LSR_TX_EMPTY) == 0) {
+			CPU::pause();
+		}
+		for (size_t n = 0; n < UART_FIFO_SIZE && i < data.size(); n++) {
+			IO::write<uint8_t>(this->port_m + UART_OFFSET_DATA, data[i++]);
+		}
+	}
+	return data.size();
+}
+
+bool UART::enableInterrupts() {
+	if (this->interrupts_m) {
+		return true;
+	}
+
+	auto irq = portToIRQ(this->port_m);
+	auto &requested = irqRequested[irq - 3];
+
+	Interrupts::Guard guard;
+	if (!requested) {
+		requested = SoftIRQ::request_irq(irq, irqHandler);
+		if (!requested) {
+			return false;
+		}
+	}
+
+	instances_m[portToIndex(this->port_m)] = this;
+	this->interrupts_m = true;
+	IO::write<uint8_t>(this->port_m + UART_OFFSET_INTERRUPT_ENABLE, UART_IER_RX_AVAILABLE);
+	return true;
+}
+
+void UART::disableInterrupts() {
+	if (!this->interrupts_m) {
+		return;
+	}
+
+	Interrupts::Guard guard;
+	IO::write<uint8_t>(this->port_m + UART_OFFSET_INTERRUPT_ENABLE, 0x00);
+	instances_m[portToIndex(this->port_m)] = nullptr;
+	this->interrupts_m = false;
+	flush();
+}
+
+size_t UART::read(uint8_t *buffer, size_t count) {
+	Interrupts::Guard guard;
+
+	return this->rx_m.read(std::span<uint8_t>(buffer, count));
+}
+
+void UART::flush() {
+	Interrupts::Guard guard;
+	while (!this->tx_m.empty()) {
+		transmit();
+	}
+}
+
+/**
+ * @brief Poll until the transmitter is idle then refill the FIFO from the TX ring
+ *
+ * @note Must be called with interrupts disabled
+ */
+void UART::transmit() {
+	while ((IO::read<uint8_t>(this->port_m + UART_OFFSET_LINE_STATUS) & UART_LSR_TX_EMPTY) == 0) {
+		CPU::pause();
+	}
+	for (size_t i = 0; i < UART_FIFO_SIZE && !this->tx_m.empty(); i++) {
+		IO::write<uint8_t>(this->port_m + UART_OFFSET_DATA, this->tx_m.front());
+		this->tx_m.pop_front();
+	}
+}
+
+/**
+ * @brief Service all pending interrupt conditions of the port
+ *
+ */
+void UART::handleInterrupt() {
+	Interrupts::Guard guard;
+
+	// reading IIR acknowledges THR empty, draining RBR acknowledges RX
+	while ((IO::read<uint8_t>(this->port_m + UART_OFFSET_INTERRUPT_ID) & UART_IIR_NO_INTERRUPT) == 0) {
+		while (IO::read<uint8_t>(this->port_m + UART_OFFSET_LINE_STATUS) & UART_LSR_DATA_READY) {
+			auto value = IO::read<uint8_t>(this->port_m + UART_OFFSET_DATA);
+			this->rx_m.try_push(value);
+		}
+
+		if (IO::read<uint8_t>(this->port_m + UART_OFFSET_LINE_STATUS) & UART_LSR_TX_EMPTY) {
+			if (this->tx_m.empty()) {
+				IO::write<uint8_t>(this->port_m + UART_OFFSET_INTERRUPT_ENABLE, UART_IER_RX_AVAILABLE);
+			} else {
+				transmit();
+			}
+		}
+	}
+}
+
+/**
+ * @brief Threaded IRQ handler shared by all ports, runs in softirq context
+ *
+ */
+void UART::irqHandler() {
+	for (auto uart : instances_m) {
+		if (uart) {
+			uart->handleInterrupt();
+		}
 	}
-	IO::write<uint8_t>(this->port_m, value);
 }
 
 // TODO I really should write a better version of this
\ No newline at end of file
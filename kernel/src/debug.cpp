@@ -18,79 +18,29 @@
 
 #include <kernel/arch/ksyms.h>
 #include <kernel/debug.h>
-
-void Debug::log(const char *format, ...) {
-	va_list ap;
-	va_start(ap, format);
-	fputs("         ", stdout);
-	vprintf(format, ap);
-	putchar('\n');
-	va_end(ap);
-}
-
-void Debug::log_failure(const char *format, ...) {
-	va_list ap;
-	va_start(ap, format);
-	fputs("[\u001b[31m FAIL \u001b[0m] ", stdout);
-	vprintf(format, ap);
-	putchar('\n');
-	va_end(ap);
-}
-
-void Debug::log_info(const char *format, ...) {
-	va_list ap;
-	va_start(ap, format);
-	fputs("[\u001b[36m INFO \u001b[0m] ", stdout);
-	vprintf(format, ap);
-	putchar('\n');
-	va_end(ap);
-}
-
-void Debug::log_ok(const char *format, ...) {
-	va_list ap;
-	va_start(ap, format);
-	fputs("[\u001b[32m  OK  \u001b[0m] ", stdout);
-	vprintf(format, ap);
-	putchar('\n');
-	va_end(ap);
-}
-
-void Debug::log_test(const char *format, ...) {
-	va_list ap;
-	va_start(ap, format);
-	fputs("[\u001b[35m TEST \u001b[0m] ", stdout);
-	vprintf(format, ap);
-	putchar('\n');
-	va_end(ap);
-}
-
-void Debug::log_warning(const char *format, ...) {
-	va_list ap;
-	va_start(ap, format);
-	fputs("[\u001b[33m WARN \u001b[0m] ", stdout);
-	vprintf(format, ap);
-	putchar('\n');
-	va_end(ap);
-}
-
-void Debug::log_raw(const char *format, ...) {
-	va_list ap;
-	va_start(ap, format);
-	vprintf(format, ap);
-	va_end(ap);
-}
+#include <kernel/initcall.h>
+#include <kernel/log.h>
 
 void Debug::trace_stack(void) {
+	Initcall::require("ksyms");
 	Debug::trace_stack(__builtin_frame_address(0));
 }
 
 void Debug::trace_stack(void *frame_ptr) {
 	unsigned int count = 0;
-	printf("Stack Trace:%s\n", KSyms::is_available() ? "" : " (no symbol table)");
+	// keep direct output in order with any pending log records
+	Log::flush();
+	// only symbolize with a table that is already loaded, this may be called from a panic
+	bool symbols = KSyms::is_available();
+	printf("Stack Trace:%s\n", symbols ? "" : " (no symbol table)");
 
 	while (frame_ptr && count < DEFAULT_MAX_FRAMES) {
 		uintptr_t return_address = *(static_cast<uintptr_t *>(frame_ptr) + 1);
-		auto [symbol_name, symbol_address] = KSyms::get_symbol(reinterpret_cast<void *>(return_address));
+		std::pair<std::string_view, uintptr_t> symbol = {nullptr, 0};
+		if (symbols) {
+			symbol = KSyms::get_symbol(reinterpret_cast<void *>(return_address));
+		}
+		auto [symbol_name, symbol_address] = symbol;
 
 		// TODO Demangle C++ symbols
 
@@ -122,6 +72,8 @@ void Debug::dump_memory(const void *start, const void *end) {
 	}
 	uintptr_t mask = (-1UL >> (64 - (digits * 4)));
 
+	Log::flush();
+
 	printf("Memory Dump: [%p => %p] (%zu bytes)\n", start, end, last - ptr);
 
 	while (ptr < last) {
@@ -0,0 +1,206 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-17
+ * @brief Initcall framework for dependency ordered, parallel and deferred subsystem initialization
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cassert>
+#include <cstring>
+
+#include <atomic>
+#include <span>
+
+#include <kernel/arch/interrupts.h>
+#include <kernel/arch/scheduler.h>
+#include <kernel/arch/x86_64/interrupts/guard.h>
+#include <kernel/debug.h>
+#include <kernel/initcall.h>
+#include <kernel/profiler.h>
+
+extern "C" const Initcall::Entry __kernel_initcalls_start;
+extern "C" const Initcall::Entry __kernel_initcalls_end;
+
+/**
+ * @brief The state of an initcall
+ *
+ */
+enum class State : uint8_t {
+	PENDING,
+	RUNNING,
+	DONE
+};
+
+// zero initialized, i.e. State::PENDING
+static std::atomic<State> states[Initcall::MAX_INITCALLS];
+static std::atomic<size_t> workers_running = 0;
+
+/**
+ * @brief Get all registered initcalls
+ *
+ * @return The registered initcalls
+ */
+static std::span<const Initcall::Entry> __entries(void) {
+	const std::span entries(&__kernel_initcalls_start, &__kernel_initcalls_end);
+	assert(entries.size() <= Initcall::MAX_INITCALLS);
+	return entries;
+}
+
+/**
+ * @brief Find an initcall by name
+ *
+ * @param name The name of the initcall
+ * @return The index of the initcall, or MAX_INITCALLS if it is not registered
+ */
+static size_t __find(const char *name) {
+	auto entries = __entries();
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (strcmp(entries[i].name, name) == 0) {
+			return i;
+		}
+	}
+	return Initcall::MAX_INITCALLS;
+}
+
+/**
+ * @brief Check if a parallel initcall can be run, i.e. its parallel dependencies have finished
+ *
+ * @param entry The initcall
+ * @return true if it can be run, false otherwise
+ *
+ * @note Deferred dependencies are run on demand by the worker that claims the initcall
+ */
+static bool __is_ready(const Initcall::Entry &entry) {
+	auto entries = __entries();
+	for (auto dependency : entry.depends) {
+		if (dependency == nullptr) {
+			break;
+		}
+		auto index = __find(dependency);
+		assert(index != Initcall::MAX_INITCALLS);
+		if (entries[index].mode == Initcall::Mode::PARALLEL && states[index] != State::DONE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Run an initcall that has been claimed by the calling thread, after running any outstanding dependencies
+ *
+ * @param index The index of the initcall
+ */
+static void __invoke(size_t index) {
+	auto &entry = __entries()[index];
+	for (auto dependency : entry.depends) {
+		if (dependency == nullptr) {
+			break;
+		}
+		Initcall::require(dependency);
+	}
+	Profiler::measure(entry.name, entry.func);
+	states[index] = State::DONE;
+}
+
+/**
+ * @brief Claim a parallel initcall whose dependencies are done
+ *
+ * @param[out] index The index of the claimed initcall
+ * @return true if an initcall was claimed, false if none are ready
+ */
+static bool __claim_ready(size_t &index) {
+	Interrupts::Guard guard;
+	auto entries = __entries();
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (entries[i].mode == Initcall::Mode::PARALLEL && states[i] == State::PENDING && __is_ready(entries[i])) {
+			states[i] = State::RUNNING;
+			index = i;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Check if every parallel initcall has finished
+ *
+ * @return true if they have all finished, false otherwise
+ */
+static bool __parallel_done(void) {
+	auto entries = __entries();
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (entries[i].mode == Initcall::Mode::PARALLEL && states[i] != State::DONE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Worker thread, runs parallel initcalls until they have all finished
+ *
+ */
+static void __worker(void) {
+	while (!__parallel_done()) {
+		size_t index;
+		if (__claim_ready(index)) {
+			__invoke(index);
+		} else {
+			// waiting on a dependency that another worker is running
+			Scheduler::yield();
+		}
+	}
+	workers_running--;
+}
+
+void Initcall::run(void) {
+	auto entries = __entries();
+	Debug::log("Running %zu initcalls on %zu workers...", entries.size(), WORKER_COUNT);
+
+	// TODO run workers on the APs once SMP is supported
+	workers_running = WORKER_COUNT;
+	for (size_t i = 0; i < WORKER_COUNT; i++) {
+		Scheduler::create_thread(__worker);
+	}
+	while (workers_running != 0) {
+		Scheduler::yield();
+	}
+
+	Debug::log_ok("Initcalls finished");
+}
+
+bool Initcall::require(const char *name) {
+	auto index = __find(name);
+	if (index == MAX_INITCALLS) {
+		Debug::log_failure("Unknown initcall: %s", name);
+		return false;
+	}
+	if (states[index] == State::DONE) {
+		return true;
+	}
+
+	auto expected = State::PENDING;
+	if (states[index].compare_exchange_strong(expected, State::RUNNING)) {
+		__invoke(index);
+		return true;
+	}
+
+	// another thread is running it, which we can only wait for from a thread with interrupts enabled
+	if (Scheduler::Thread::current() == nullptr || !Interrupts::is_enabled()) {
+		return states[index] == State::DONE;
+	}
+	while (states[index] != State::DONE) {
+		Scheduler::yield();
+	}
+	return true;
+}
+
+bool Initcall::is_done(const char *name) {
+	auto index = __find(name);
+	return index != MAX_INITCALLS && states[index] == State::DONE;
+}
\ No newline at end of file
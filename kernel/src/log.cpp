@@ -0,0 +1,301 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-15
+ * @brief Per-CPU kernel log ring buffer
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <kernel/arch/cpu.h>
+#include <kernel/arch/interrupts.h>
+#include <kernel/arch/scheduler.h>
+#include <kernel/arch/x86_64/interrupts/guard.h>
+#include <kernel/log.h>
+
+/**
+ * @brief A slot in the ring buffer
+ *
+ * @details The sequence number of a slot is stored relative to its index so that a zeroed ring is valid, which allows
+ * logging before global constructors are run. A slot at position pos is free when its sequence is pos and holds a
+ * committed record when its sequence is pos + 1.
+ */
+struct Slot {
+	std::atomic<uint64_t> sequence;
+	Log::Record record;
+};
+
+/**
+ * @brief A bounded multi-producer ring buffer, producers are lock-free and the consumer runs with interrupts disabled
+ *
+ */
+struct Ring {
+	std::atomic<uint64_t> head;
+	uint64_t tail;
+	Slot slots[Log::RING_SIZE];
+};
+
+// TODO one ring per CPU once SMP is supported
+static Ring rings[1];
+
+static bool synchronous = false;
+static Scheduler::Thread *drain_thread = nullptr;
+
+// zero initialized, i.e. Level::LOG, so everything compiled in is logged by default
+static Log::Level levels[static_cast<size_t>(Log::Category::COUNT)];
+
+static const char *const prefixes[] = {
+	"         ",
+	"[\u001b[36m INFO \u001b[0m] ",
+	"[\u001b[32m  OK  \u001b[0m] ",
+	"[\u001b[35m TEST \u001b[0m] ",
+	"[\u001b[33m WARN \u001b[0m] ",
+	"[\u001b[31m FAIL \u001b[0m] ",
+	"",
+};
+
+/**
+ * @brief Get the sequence number of a slot
+ *
+ * @param ring The ring the slot belongs to
+ * @param pos The position of the slot
+ * @return The sequence number of the slot
+ */
+static inline uint64_t __get_sequence(Ring &ring, uint64_t pos) {
+	auto index = pos % Log::RING_SIZE;
+	return ring.slots[index].sequence.load(std::memory_order::acquire) + index;
+}
+
+/**
+ * @brief Set the sequence number of a slot
+ *
+ * @param ring The ring the slot belongs to
+ * @param pos The position of the slot
+ * @param sequence The new sequence number
+ */
+static inline void __set_sequence(Ring &ring, uint64_t pos, uint64_t sequence) {
+	auto index = pos % Log::RING_SIZE;
+	ring.slots[index].sequence.store(sequence - index, std::memory_order::release);
+}
+
+/**
+ * @brief Write a record to the console
+ *
+ * @param record The record to write
+ */
+static void __output(const Log::Record &record) {
+	auto prefix = prefixes[static_cast<size_t>(record.level)];
+	write(STDOUT_FILENO, prefix, strlen(prefix));
+
+	if (record.level != Log::Level::RAW) {
+		// records can be drained long after they were made, so say when and where
+		char header[64];
+		auto length = snprintf(header, sizeof(header), "\u001b[90m%016lx %u:%u\u001b[0m ", record.timestamp, record.cpu, record.thread);
+		if (length > 0) {
+			write(STDOUT_FILENO, header, std::min(static_cast<size_t>(length), sizeof(header) - 1));
+		}
+	}
+
+	if (record.binary) {
+		Log::BinaryPayload payload;
+		memcpy(&payload, record.message, sizeof(payload));
+
+		// unused arguments are ignored, only integer and pointer arguments are supported
+		char buffer[sizeof(record.message)];
+		auto &a = payload.args;
+		auto length = snprintf(buffer, sizeof(buffer), payload.format, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+		if (length > 0) {
+			write(STDOUT_FILENO, buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+		}
+	} else {
+		write(STDOUT_FILENO, record.message, record.length);
+	}
+
+	if (record.level != Log::Level::RAW) {
+		write(STDOUT_FILENO, "\n", 1);
+	}
+}
+
+/**
+ * @brief Append a record to a ring
+ *
+ * @param ring The ring to append to
+ * @param record The record to append
+ * @return true if the record was appended, false if the ring is full
+ */
+static bool __push(Ring &ring, const Log::Record &record) {
+	auto pos = ring.head.load(std::memory_order::relaxed);
+
+	while (true) {
+		auto diff = static_cast<int64_t>(__get_sequence(ring, pos) - pos);
+		if (diff < 0) {
+			return false;
+		}
+		if (diff == 0 && ring.head.compare_exchange_weak(pos, pos + 1, std::memory_order::relaxed)) {
+			break;
+		}
+		if (diff > 0) {
+			pos = ring.head.load(std::memory_order::relaxed);
+		}
+	}
+
+	auto &slot = ring.slots[pos % Log::RING_SIZE];
+	memcpy(&slot.record, &record, offsetof(Log::Record, message) + record.length);
+	__set_sequence(ring, pos, pos + 1);
+	return true;
+}
+
+/**
+ * @brief Remove the oldest committed record from a ring
+ *
+ * @param ring The ring to remove from
+ * @param record The record to copy into
+ * @return true if a record was removed, false if the ring is empty or the oldest record is not yet committed
+ */
+static bool __pop(Ring &ring, Log::Record &record) {
+	Interrupts::Guard guard;
+
+	auto pos = ring.tail;
+	if (__get_sequence(ring, pos) != pos + 1) {
+		return false;
+	}
+
+	auto &slot = ring.slots[pos % Log::RING_SIZE];
+	memcpy(&record, &slot.record, offsetof(Log::Record, message) + slot.record.length);
+	__set_sequence(ring, pos, pos + Log::RING_SIZE);
+	ring.tail = pos + 1;
+	return true;
+}
+
+/**
+ * @brief Entry point of the log drain thread
+ *
+ */
+static void __drain(void) {
+	auto &ring = rings[0];
+
+	while (true) {
+		Log::flush();
+
+		Interrupts::Guard guard;
+		if (__get_sequence(ring, ring.tail) != ring.tail + 1) {
+			Scheduler::block();
+		}
+	}
+}
+
+void Log::init(void) {
+	drain_thread = Scheduler::create_thread(__drain);
+}
+
+/**
+ * @brief Fill in the header of a record
+ *
+ * @param record The record to fill in
+ * @param level The level of the record
+ * @param category The category of the record
+ */
+static void __init_record(Log::Record &record, Log::Level level, Log::Category category) {
+	record.timestamp = CPU::get_tsc();
+	record.cpu = 0;
+	auto thread = Scheduler::Thread::current();
+	record.thread = thread ? thread->id : 0;
+	record.level = level;
+	record.category = category;
+}
+
+/**
+ * @brief Append a record to the ring buffer, or write it out directly if that is not possible
+ *
+ * @param record The record to submit
+ */
+static void __submit(const Log::Record &record) {
+	if (!synchronous && drain_thread) {
+		if (__push(rings[0], record)) {
+			Scheduler::wake(drain_thread);
+			return;
+		}
+		// ring is full, write out what we can to keep the output in order
+		Log::flush();
+	}
+
+	__output(record);
+}
+
+void Log::set_level(Category category, Level level) {
+	levels[static_cast<size_t>(category)] = level;
+}
+
+void Log::set_level(Level level) {
+	for (auto &l : levels) {
+		l = level;
+	}
+}
+
+Log::Level Log::get_level(Category category) {
+	return levels[static_cast<size_t>(category)];
+}
+
+void Log::write(Level level, Category category, const char *format, va_list ap) {
+	if (level < levels[static_cast<size_t>(category)]) {
+		return;
+	}
+
+	Record record;
+	__init_record(record, level, category);
+	record.binary = false;
+
+	auto length = vsnprintf(record.message, sizeof(record.message), format, ap);
+	if (length < 0) {
+		length = 0;
+	}
+	if (static_cast<size_t>(length) >= sizeof(record.message)) {
+		length = sizeof(record.message) - 1;
+		memcpy(&record.message[length - 3], "...", 3);
+	}
+	record.length = length;
+
+	__submit(record);
+}
+
+void Log::write_binary(Level level, Category category, const char *format, const uint64_t *args, size_t count) {
+	if (level < levels[static_cast<size_t>(category)]) {
+		return;
+	}
+
+	Record record;
+	__init_record(record, level, category);
+	record.binary = true;
+
+	BinaryPayload payload{};
+	payload.format = format;
+	memcpy(payload.args, args, std::min(count, MAX_BINARY_ARGS) * sizeof(uint64_t));
+	memcpy(record.message, &payload, sizeof(payload));
+	record.length = sizeof(payload);
+
+	__submit(record);
+}
+
+void Log::flush(void) {
+	Record record;
+	for (auto &ring : rings) {
+		while (__pop(ring, record)) {
+			__output(record);
+		}
+	}
+}
+
+void Log::set_synchronous(void) {
+	synchronous = true;
+	flush();
+}
\ No newline at end of file
@@ -10,12 +10,16 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <kernel/arch/console.h>
 #include <kernel/arch/cpu.h>
 #include <kernel/debug.h>
+#include <kernel/log.h>
 #include <kernel/panic.h>
 
 void Kernel::panic(std::string_view msg) {
+	Log::set_synchronous();
 	Debug::log_failure("Kernel panic: %s", msg.data());
 	Debug::trace_stack(__builtin_frame_address(0));
+	Console::flush();
 	CPU::stop();
 }
\ No newline at end of file
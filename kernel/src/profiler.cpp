@@ -0,0 +1,121 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-16
+ * @brief TSC based profiler for timing boot phases
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <kernel/arch/cpu.h>
+#include <kernel/arch/interrupts.h>
+#include <kernel/arch/scheduler.h>
+#include <kernel/arch/x86_64/interrupts/guard.h>
+#include <kernel/debug.h>
+#include <kernel/profiler.h>
+
+/**
+ * @brief A timed phase
+ *
+ */
+struct Phase {
+	const char *name;
+	uint64_t start;
+	uint64_t end;
+	size_t depth;
+	size_t thread;
+};
+
+// static storage as profiling starts before the heap is available
+static Phase phases[Profiler::MAX_PHASES];
+static size_t phase_count = 0;
+static uint64_t first_tsc = 0;
+
+/**
+ * @brief Get the nominal TSC frequency from CPUID
+ *
+ * @return The TSC frequency in kHz, or 0 if it is not reported
+ */
+static uint64_t __tsc_khz(void) {
+	uint32_t eax, ebx, ecx, edx;
+	asm volatile("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0), "c"(0));
+	auto max_leaf = eax;
+
+	if (max_leaf >= 0x15) {
+		// TSC = crystal * ebx / eax
+		asm volatile("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0x15), "c"(0));
+		if (eax != 0 && ebx != 0 && ecx != 0) {
+			return static_cast<uint64_t>(ecx) * ebx / eax / 1000;
+		}
+	}
+	if (max_leaf >= 0x16) {
+		// processor base frequency in MHz
+		asm volatile("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0x16), "c"(0));
+		if ((eax & 0xFFFF) != 0) {
+			return static_cast<uint64_t>(eax & 0xFFFF) * 1000;
+		}
+	}
+	return 0;
+}
+
+size_t Profiler::begin(const char *name) {
+	auto now = CPU::get_tsc();
+	Interrupts::Guard guard;
+	if (phase_count == 0) {
+		first_tsc = now;
+	}
+	if (phase_count >= MAX_PHASES) {
+		return MAX_PHASES;
+	}
+
+	auto thread = Scheduler::Thread::current();
+	auto &phase = phases[phase_count];
+	phase.name = name;
+	phase.thread = thread ? thread->id : 0;
+
+	// phases are nested under the unfinished phases of the same thread, as initcalls may run concurrently
+	phase.depth = 0;
+	for (size_t i = 0; i < phase_count; i++) {
+		if (phases[i].end == 0 && phases[i].thread == phase.thread) {
+			phase.depth++;
+		}
+	}
+
+	phase.start = now;
+	phase.end = 0;
+	return phase_count++;
+}
+
+void Profiler::end(size_t index) {
+	auto now = CPU::get_tsc();
+	if (index >= MAX_PHASES) {
+		return;
+	}
+
+	phases[index].end = now;
+}
+
+void Profiler::dump(void) {
+	auto total = CPU::get_tsc() - first_tsc;
+	auto khz = __tsc_khz();
+
+	Debug::log_info("Boot profile (%zu phases, TSC %s%lu kHz):", phase_count, khz ? "" : "unknown, ", khz);
+	Debug::log("%-40s %6s %16s %12s %6s", "Phase", "Thread", "Cycles", "Time (us)", "%");
+
+	for (size_t i = 0; i < phase_count; i++) {
+		auto &phase = phases[i];
+		auto cycles = phase.end ? phase.end - phase.start : 0;
+		auto us = khz ? cycles * 1000 / khz : 0;
+		auto permille = total ? cycles * 1000 / total : 0;
+
+		Debug::log("%*s%-*s %6zu %16lu %12lu %4lu.%lu",
+				   static_cast<int>(phase.depth * 2), "",
+				   static_cast<int>(40 - phase.depth * 2), phase.name,
+				   phase.thread, cycles, us, permille / 10, permille % 10);
+	}
+
+	Debug::log("%-40s %6s %16lu %12lu", "Total (first phase to now)", "", total, khz ? total * 1000 / khz : 0);
+}
\ No newline at end of file
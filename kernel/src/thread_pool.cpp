@@ -0,0 +1,122 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-18
+ * @brief Pool of kernel worker threads for running short tasks in parallel
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cassert>
+
+#include <kernel/arch/scheduler.h>
+#include <kernel/arch/x86_64/interrupts/guard.h>
+#include <kernel/thread_pool.h>
+
+using ThreadPool::Task;
+
+// LIFO, so the most recently split (and smallest) tasks are picked up first
+static Task *queue = nullptr;
+static Scheduler::Thread *workers[ThreadPool::WORKER_COUNT];
+static bool started = false;
+
+/**
+ * @brief Run a task that has been removed from the queue
+ *
+ * @param task The task to run
+ */
+static void __run(Task &task) {
+	task.func(task.arg);
+	task.state = Task::State::DONE;
+}
+
+/**
+ * @brief Entry point of a worker thread
+ *
+ */
+static void __worker(void) {
+	while (true) {
+		Task *task;
+		{
+			Interrupts::Guard guard;
+			if (queue == nullptr) {
+				Scheduler::block();
+				continue;
+			}
+			task = queue;
+			queue = task->next;
+			task->state = Task::State::RUNNING;
+		}
+		__run(*task);
+	}
+}
+
+/**
+ * @brief Create the worker threads
+ *
+ * @note Must be called with interrupts disabled
+ */
+static void __start(void) {
+	// TODO run workers on the APs once SMP is supported
+	for (auto &worker : workers) {
+		worker = Scheduler::create_thread(__worker);
+	}
+	started = true;
+}
+
+/**
+ * @brief Take a task back out of the queue if no worker has picked it up yet
+ *
+ * @param task The task to reclaim
+ * @return true if the task was reclaimed and should be run by the caller, false otherwise
+ */
+static bool __reclaim(Task &task) {
+	Interrupts::Guard guard;
+	if (task.state != Task::State::QUEUED) {
+		return false;
+	}
+	for (auto link = &queue; *link != nullptr; link = &(*link)->next) {
+		if (*link == &task) {
+			*link = task.next;
+			break;
+		}
+	}
+	task.state = Task::State::RUNNING;
+	return true;
+}
+
+void ThreadPool::submit(Task &task) {
+	assert(task.state != Task::State::QUEUED && task.state != Task::State::RUNNING);
+
+	if (Scheduler::Thread::current() == nullptr) {
+		task.state = Task::State::RUNNING;
+		__run(task);
+		return;
+	}
+
+	Interrupts::Guard guard;
+	if (!started) {
+		__start();
+	}
+	task.state = Task::State::QUEUED;
+	task.next = queue;
+	queue = &task;
+	for (auto worker : workers) {
+		if (Scheduler::wake(worker)) {
+			break;
+		}
+	}
+}
+
+void ThreadPool::wait(Task &task) {
+	if (__reclaim(task)) {
+		__run(task);
+		return;
+	}
+	while (task.state != Task::State::DONE) {
+		Scheduler::yield();
+	}
+}
\ No newline at end of file
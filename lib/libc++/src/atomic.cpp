@@ -0,0 +1,126 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-24
+ * @brief Wait queues for std::atomic<T>::wait and std::atomic<T>::notify_*
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <bits/hash.h>
+#include <intrusive_list>
+
+#include <kernel/arch/cpu.h>
+#include <kernel/arch/interrupts.h>
+#include <kernel/arch/scheduler.h>
+#include <kernel/arch/x86_64/interrupts/guard.h>
+
+namespace {
+	/**
+	 * @brief A thread blocked on an address, lives on the waiting thread's stack
+	 *
+	 */
+	struct Waiter {
+		const volatile void *address;
+		Scheduler::Thread *thread;
+		std::intrusive_list_hook hook;
+	};
+
+	using WaitQueue = std::intrusive_list<Waiter, &Waiter::hook>;
+
+	// must be a power of 2
+	constexpr size_t BUCKET_COUNT = 64;
+
+	// TODO a spin lock per bucket once there is more than one CPU
+	WaitQueue buckets[BUCKET_COUNT];
+
+	/**
+	 * @brief Get the wait queue for an address
+	 *
+	 * @param address The address
+	 * @return The wait queue
+	 */
+	WaitQueue &bucket(const volatile void *address) {
+		auto key = reinterpret_cast<uintptr_t>(address);
+		return buckets[std::__detail::__hash_mix(key, 0x9e3779b97f4a7c15) & (BUCKET_COUNT - 1)];
+	}
+
+	/**
+	 * @brief Check if the value at an address is still equal to an old value
+	 *
+	 * @param address The address of the value
+	 * @param old The old value
+	 * @param size The size of the value
+	 * @return true if the value is unchanged, false otherwise
+	 */
+	bool unchanged(const volatile void *address, const void *old, size_t size) {
+		auto ptr = const_cast<const void *>(address);
+		switch (size) {
+			case 1:
+				return __atomic_load_n(static_cast<const uint8_t *>(ptr), __ATOMIC_SEQ_CST) ==
+					   *static_cast<const uint8_t *>(old);
+			case 2:
+				return __atomic_load_n(static_cast<const uint16_t *>(ptr), __ATOMIC_SEQ_CST) ==
+					   *static_cast<const uint16_t *>(old);
+			case 4:
+				return __atomic_load_n(static_cast<const uint32_t *>(ptr), __ATOMIC_SEQ_CST) ==
+					   *static_cast<const uint32_t *>(old);
+			case 8:
+				return __atomic_load_n(static_cast<const uint64_t *>(ptr), __ATOMIC_SEQ_CST) ==
+					   *static_cast<const uint64_t *>(old);
+			default:
+				__atomic_thread_fence(__ATOMIC_SEQ_CST);
+				return __builtin_memcmp(ptr, old, size) == 0;
+		}
+	}
+}
+
+namespace std {
+	namespace __detail {
+		void __atomic_wait(const volatile void *address, const void *old, size_t size) {
+			auto thread = Scheduler::Thread::current();
+			if (thread == nullptr || !Interrupts::is_enabled()) {
+				// nothing to switch to, or the caller cannot be switched away from, so let it spin
+				CPU::pause();
+				return;
+			}
+
+			// the value is rechecked with interrupts disabled so a notify cannot be missed before block()
+			Interrupts::Guard guard;
+			if (!unchanged(address, old, size)) {
+				return;
+			}
+
+			Waiter waiter{address, const_cast<Scheduler::Thread *>(thread), {}};
+			auto &queue = bucket(address);
+			queue.push_back(waiter);
+			Scheduler::block();
+
+			// woken by something other than __atomic_notify
+			if (waiter.hook.is_linked()) {
+				queue.erase(waiter);
+			}
+		}
+
+		void __atomic_notify(const volatile void *address, bool all) {
+			Interrupts::Guard guard;
+			auto &queue = bucket(address);
+			for (auto it = queue.begin(); it != queue.end();) {
+				if (it->address != address) {
+					++it;
+					continue;
+				}
+				auto thread = it->thread;
+				it = queue.erase(it);
+				Scheduler::wake(thread);
+				if (!all) {
+					break;
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
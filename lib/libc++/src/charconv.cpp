@@ -0,0 +1,777 @@
+/**
+ * @author Jayden Grubb (contact@jaydengrubb.com)
+ * @date 2024-11-27
+ * @brief Conversions from floating point numbers to characters
+ *
+ * Copyright (c) 2024, Jayden Grubb
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+#include "ryu_tables.h"
+
+namespace {
+	template <typename T>
+	struct FloatTraits;
+
+	template <>
+	struct FloatTraits<float> {
+		using Bits = uint32_t;
+		static constexpr int MANTISSA_BITS = 23;
+		static constexpr int EXPONENT_BITS = 8;
+		static constexpr int BIAS = 127;
+	};
+
+	template <>
+	struct FloatTraits<double> {
+		using Bits = uint64_t;
+		static constexpr int MANTISSA_BITS = 52;
+		static constexpr int EXPONENT_BITS = 11;
+		static constexpr int BIAS = 1023;
+	};
+
+	/**
+	 * @brief A decimal number, mantissa * 10^exponent
+	 *
+	 */
+	struct Decimal {
+		uint64_t mantissa;
+		int32_t exponent;
+	};
+
+#pragma region Ryu
+	// Ryu: Fast Float-to-String Conversion, Ulf Adams, PLDI 2018
+
+	// ceil(log2(5^e)) for 0 <= e <= 3528, or 1 for e = 0
+	uint32_t pow5_bits(int32_t e) {
+		return ((static_cast<uint32_t>(e) * 1217359) >> 19) + 1;
+	}
+
+	// floor(log10(2^e)) for 0 <= e <= 1650
+	uint32_t log10_pow2(int32_t e) {
+		return (static_cast<uint32_t>(e) * 78913) >> 18;
+	}
+
+	// floor(log10(5^e)) for 0 <= e <= 2620
+	uint32_t log10_pow5(int32_t e) {
+		return (static_cast<uint32_t>(e) * 732923) >> 20;
+	}
+
+	uint32_t pow5_factor(uint64_t value) {
+		uint32_t count = 0;
+		while (value % 5 == 0) {
+			value /= 5;
+			count++;
+		}
+		return count;
+	}
+
+	bool multiple_of_pow5(uint64_t value, uint32_t p) {
+		return pow5_factor(value) >= p;
+	}
+
+	bool multiple_of_pow2(uint64_t value, uint32_t p) {
+		return (value & ((1ull << p) - 1)) == 0;
+	}
+
+	uint64_t mul_shift64(uint64_t m, const uint64_t *mul, int32_t j) {
+		auto low = static_cast<unsigned __int128>(m) * mul[0];
+		auto high = static_cast<unsigned __int128>(m) * mul[1];
+		return static_cast<uint64_t>(((low >> 64) + high) >> (j - 64));
+	}
+
+	uint32_t mul_shift32(uint32_t m, uint64_t factor, int32_t shift) {
+		uint64_t low = static_cast<uint64_t>(m) * static_cast<uint32_t>(factor);
+		uint64_t high = static_cast<uint64_t>(m) * (factor >> 32);
+		return static_cast<uint32_t>(((low >> 32) + high) >> (shift - 32));
+	}
+
+	/**
+	 * @brief Find the shortest decimal that rounds to a double
+	 *
+	 * @param ieee_mantissa The mantissa field of the double
+	 * @param ieee_exponent The exponent field of the double
+	 * @return The shortest decimal
+	 */
+	Decimal ryu(uint64_t ieee_mantissa, uint32_t ieee_exponent) {
+		using Traits = FloatTraits<double>;
+
+		int32_t e2;
+		uint64_t m2;
+		if (ieee_exponent == 0) {
+			e2 = 1 - Traits::BIAS - Traits::MANTISSA_BITS - 2;
+			m2 = ieee_mantissa;
+		} else {
+			e2 = static_cast<int32_t>(ieee_exponent) - Traits::BIAS - Traits::MANTISSA_BITS - 2;
+			m2 = (1ull << Traits::MANTISSA_BITS) | ieee_mantissa;
+		}
+		const bool accept_bounds = (m2 & 1) == 0;
+
+		// the interval of decimals that round to this number is (4 * m2 - 1 - mm_shift, 4 * m2 + 2) * 2^e2
+		const uint64_t mv = 4 * m2;
+		const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+		uint64_t vr, vp, vm;
+		int32_t e10;
+		bool vm_trailing_zeros = false;
+		bool vr_trailing_zeros = false;
+		if (e2 >= 0) {
+			const uint32_t q = log10_pow2(e2) - (e2 > 3);
+			e10 = static_cast<int32_t>(q);
+			const int32_t k = Ryu::POW5_INV_BITCOUNT + pow5_bits(static_cast<int32_t>(q)) - 1;
+			const int32_t i = -e2 + static_cast<int32_t>(q) + k;
+			vr = mul_shift64(4 * m2, Ryu::POW5_INV_SPLIT[q], i);
+			vp = mul_shift64(4 * m2 + 2, Ryu::POW5_INV_SPLIT[q], i);
+			vm = mul_shift64(4 * m2 - 1 - mm_shift, Ryu::POW5_INV_SPLIT[q], i);
+			if (q <= 21) {
+				if (mv % 5 == 0) {
+					vr_trailing_zeros = multiple_of_pow5(mv, q);
+				} else if (accept_bounds) {
+					vm_trailing_zeros = multiple_of_pow5(mv - 1 - mm_shift, q);
+				} else {
+					vp -= multiple_of_pow5(mv + 2, q);
+				}
+			}
+		} else {
+			const uint32_t q = log10_pow5(-e2) - (-e2 > 1);
+			e10 = static_cast<int32_t>(q) + e2;
+			const int32_t i = -e2 - static_cast<int32_t>(q);
+			const int32_t k = pow5_bits(i) - Ryu::POW5_BITCOUNT;
+			const int32_t j = static_cast<int32_t>(q) - k;
+			vr = mul_shift64(4 * m2, Ryu::POW5_SPLIT[i], j);
+			vp = mul_shift64(4 * m2 + 2, Ryu::POW5_SPLIT[i], j);
+			vm = mul_shift64(4 * m2 - 1 - mm_shift, Ryu::POW5_SPLIT[i], j);
+			if (q <= 1) {
+				vr_trailing_zeros = true;
+				if (accept_bounds) {
+					vm_trailing_zeros = mm_shift == 1;
+				} else {
+					vp--;
+				}
+			} else if (q < 63) {
+				vr_trailing_zeros = multiple_of_pow2(mv, q);
+			}
+		}
+
+		// remove digits while the bounds still differ
+		int32_t removed = 0;
+		uint8_t last_removed = 0;
+		uint64_t output;
+		if (vm_trailing_zeros || vr_trailing_zeros) [[unlikely]] {
+			while (vp / 10 > vm / 10) {
+				vm_trailing_zeros &= vm % 10 == 0;
+				vr_trailing_zeros &= last_removed == 0;
+				last_removed = static_cast<uint8_t>(vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				removed++;
+			}
+			if (vm_trailing_zeros) {
+				while (vm % 10 == 0) {
+					vr_trailing_zeros &= last_removed == 0;
+					last_removed = static_cast<uint8_t>(vr % 10);
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+					removed++;
+				}
+			}
+			if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) {
+				// exactly halfway, round to even
+				last_removed = 4;
+			}
+			output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+		} else {
+			bool round_up = false;
+			if (vp / 100 > vm / 100) {
+				// remove two digits at a time while possible
+				round_up = vr % 100 >= 50;
+				vr /= 100;
+				vp /= 100;
+				vm /= 100;
+				removed += 2;
+			}
+			while (vp / 10 > vm / 10) {
+				round_up = vr % 10 >= 5;
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				removed++;
+			}
+			output = vr + (vr == vm || round_up);
+		}
+
+		return {output, e10 + removed};
+	}
+
+	/**
+	 * @brief Find the shortest decimal that rounds to a float
+	 *
+	 * @param ieee_mantissa The mantissa field of the float
+	 * @param ieee_exponent The exponent field of the float
+	 * @return The shortest decimal
+	 */
+	Decimal ryu(uint32_t ieee_mantissa, uint32_t ieee_exponent) {
+		using Traits = FloatTraits<float>;
+
+		// the double tables are reused, keeping only their top 64 bits
+		constexpr int POW5_INV_BITCOUNT = Ryu::POW5_INV_BITCOUNT - 64;
+		constexpr int POW5_BITCOUNT = Ryu::POW5_BITCOUNT - 64;
+		auto mul_pow5_inv = [](uint32_t m, uint32_t q, int32_t j) {
+			return mul_shift32(m, Ryu::POW5_INV_SPLIT[q][1] + 1, j);
+		};
+		auto mul_pow5 = [](uint32_t m, uint32_t i, int32_t j) {
+			return mul_shift32(m, Ryu::POW5_SPLIT[i][1], j);
+		};
+
+		int32_t e2;
+		uint32_t m2;
+		if (ieee_exponent == 0) {
+			e2 = 1 - Traits::BIAS - Traits::MANTISSA_BITS - 2;
+			m2 = ieee_mantissa;
+		} else {
+			e2 = static_cast<int32_t>(ieee_exponent) - Traits::BIAS - Traits::MANTISSA_BITS - 2;
+			m2 = (1u << Traits::MANTISSA_BITS) | ieee_mantissa;
+		}
+		const bool accept_bounds = (m2 & 1) == 0;
+
+		const uint32_t mv = 4 * m2;
+		const uint32_t mp = 4 * m2 + 2;
+		const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+		const uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+		uint32_t vr, vp, vm;
+		int32_t e10;
+		bool vm_trailing_zeros = false;
+		bool vr_trailing_zeros = false;
+		uint8_t last_removed = 0;
+		if (e2 >= 0) {
+			const uint32_t q = log10_pow2(e2);
+			e10 = static_cast<int32_t>(q);
+			const int32_t k = POW5_INV_BITCOUNT + pow5_bits(static_cast<int32_t>(q)) - 1;
+			const int32_t i = -e2 + static_cast<int32_t>(q) + k;
+			vr = mul_pow5_inv(mv, q, i);
+			vp = mul_pow5_inv(mp, q, i);
+			vm = mul_pow5_inv(mm, q, i);
+			if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+				// the loop below will not run, but one removed digit is still needed for rounding
+				const int32_t l = POW5_INV_BITCOUNT + pow5_bits(static_cast<int32_t>(q - 1)) - 1;
+				last_removed = static_cast<uint8_t>(mul_pow5_inv(mv, q - 1, -e2 + static_cast<int32_t>(q) - 1 + l) % 10);
+			}
+			if (q <= 9) {
+				if (mv % 5 == 0) {
+					vr_trailing_zeros = multiple_of_pow5(mv, q);
+				} else if (accept_bounds) {
+					vm_trailing_zeros = multiple_of_pow5(mm, q);
+				} else {
+					vp -= multiple_of_pow5(mp, q);
+				}
+			}
+		} else {
+			const uint32_t q = log10_pow5(-e2);
+			e10 = static_cast<int32_t>(q) + e2;
+			const int32_t i = -e2 - static_cast<int32_t>(q);
+			const int32_t k = pow5_bits(i) - POW5_BITCOUNT;
+			int32_t j = static_cast<int32_t>(q) - k;
+			vr = mul_pow5(mv, i, j);
+			vp = mul_pow5(mp, i, j);
+			vm = mul_pow5(mm, i, j);
+			if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+				j = static_cast<int32_t>(q) - 1 - (pow5_bits(i + 1) - POW5_BITCOUNT);
+				last_removed = static_cast<uint8_t>(mul_pow5(mv, i + 1, j) % 10);
+			}
+			if (q <= 1) {
+				vr_trailing_zeros = true;
+				if (accept_bounds) {
+					vm_trailing_zeros = mm_shift == 1;
+				} else {
+					vp--;
+				}
+			} else if (q < 31) {
+				vr_trailing_zeros = multiple_of_pow2(mv, q - 1);
+			}
+		}
+
+		int32_t removed = 0;
+		uint32_t output;
+		if (vm_trailing_zeros || vr_trailing_zeros) [[unlikely]] {
+			while (vp / 10 > vm / 10) {
+				vm_trailing_zeros &= vm % 10 == 0;
+				vr_trailing_zeros &= last_removed == 0;
+				last_removed = static_cast<uint8_t>(vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				removed++;
+			}
+			if (vm_trailing_zeros) {
+				while (vm % 10 == 0) {
+					vr_trailing_zeros &= last_removed == 0;
+					last_removed = static_cast<uint8_t>(vr % 10);
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+					removed++;
+				}
+			}
+			if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) {
+				last_removed = 4;
+			}
+			output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+		} else {
+			while (vp / 10 > vm / 10) {
+				last_removed = static_cast<uint8_t>(vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				removed++;
+			}
+			output = vr + (vr == vm || last_removed >= 5);
+		}
+
+		return {output, e10 + removed};
+	}
+#pragma endregion
+
+#pragma region Exact Conversion
+	// enough for the 767 significant digits of the smallest subnormal double
+	constexpr int MAX_DIGITS = 800;
+
+	/**
+	 * @brief The decimal digits of a number, 0.digits * 10^point
+	 *
+	 */
+	struct Digits {
+		char digits[MAX_DIGITS];
+		int count;
+		int point;
+	};
+
+	/**
+	 * @brief Write the exact decimal expansion of m * 2^e
+	 *
+	 * @param result The digits to write to
+	 * @param m The mantissa, not zero
+	 * @param e The binary exponent
+	 *
+	 * @details Fractions are scaled to integers with m * 2^e = m * 5^-e / 10^-e, the integer is then converted with
+	 * arbitrary precision arithmetic, so this is slow and only used when a precision is requested
+	 */
+	void exact_digits(Digits &result, uint64_t m, int e) {
+		// m * 5^1074 needs 2547 bits
+		constexpr int MAX_LIMBS = 82;
+		uint32_t limbs[MAX_LIMBS] = {static_cast<uint32_t>(m), static_cast<uint32_t>(m >> 32)};
+		int size = limbs[1] ? 2 : 1;
+
+		auto multiply = [&](uint32_t factor) {
+			uint64_t carry = 0;
+			for (int i = 0; i < size; i++) {
+				uint64_t product = static_cast<uint64_t>(limbs[i]) * factor + carry;
+				limbs[i] = static_cast<uint32_t>(product);
+				carry = product >> 32;
+			}
+			if (carry) {
+				limbs[size++] = static_cast<uint32_t>(carry);
+			}
+		};
+
+		if (e >= 0) {
+			for (; e >= 31; e -= 31) {
+				multiply(1u << 31);
+			}
+			multiply(1u << e);
+			e = 0;
+		} else {
+			int n = -e;
+			for (; n >= 13; n -= 13) {
+				multiply(1220703125); // 5^13
+			}
+			uint32_t factor = 1;
+			while (n-- > 0) {
+				factor *= 5;
+			}
+			multiply(factor);
+		}
+
+		// split into base 10^9 chunks, least significant first
+		uint32_t chunks[MAX_LIMBS * 32 / 29 + 1];
+		int chunk_count = 0;
+		while (size > 0) {
+			uint64_t remainder = 0;
+			for (int i = size - 1; i >= 0; i--) {
+				uint64_t current = (remainder << 32) | limbs[i];
+				limbs[i] = static_cast<uint32_t>(current / 1000000000);
+				remainder = current % 1000000000;
+			}
+			chunks[chunk_count++] = static_cast<uint32_t>(remainder);
+			while (size > 0 && limbs[size - 1] == 0) {
+				size--;
+			}
+		}
+
+		char *ptr = result.digits;
+		int len = std::__detail::__count_digits(chunks[chunk_count - 1]);
+		std::__detail::__write_decimal(ptr + len, chunks[chunk_count - 1]);
+		ptr += len;
+		for (int i = chunk_count - 2; i >= 0; i--) {
+			std::memset(ptr, '0', 9);
+			std::__detail::__write_decimal(ptr + 9, chunks[i]);
+			ptr += 9;
+		}
+
+		result.count = static_cast<int>(ptr - result.digits);
+		result.point = result.count + e;
+		while (result.digits[result.count - 1] == '0') {
+			result.count--;
+		}
+	}
+
+	/**
+	 * @brief Round to a number of significant digits, with ties rounded to even
+	 *
+	 * @param value The digits to round
+	 * @param keep The number of significant digits to keep, may be zero or negative
+	 */
+	void round_digits(Digits &value, int keep) {
+		if (keep >= value.count) {
+			return;
+		}
+		if (keep < 0) {
+			value.count = 0;
+			return;
+		}
+
+		char next = value.digits[keep];
+		bool up = next > '5';
+		if (next == '5') {
+			up = keep + 1 < value.count || (keep > 0 && (value.digits[keep - 1] - '0') % 2 == 1);
+		}
+
+		value.count = keep;
+		if (up) {
+			int i = keep - 1;
+			while (i >= 0 && value.digits[i] == '9') {
+				i--;
+			}
+			if (i < 0) {
+				value.digits[0] = '1';
+				value.count = 1;
+				value.point++;
+			} else {
+				value.digits[i]++;
+				value.count = i + 1;
+			}
+		}
+	}
+#pragma endregion
+
+#pragma region Writers
+	/**
+	 * @brief Write digits in fixed notation, [-]ddd.ddd
+	 *
+	 * @param first The beginning of the buffer
+	 * @param last The end of the buffer
+	 * @param value The digits to write, missing digits are written as zeros
+	 * @param precision The number of digits after the decimal point
+	 * @return The end of the written characters, or last and errc::value_too_large if the buffer is too small
+	 */
+	std::to_chars_result write_fixed(char *first, char *last, const Digits &value, int precision) {
+		int whole = value.point > 0 ? value.point : 1;
+		long len = whole + (precision > 0 ? 1 + precision : 0);
+		if (last - first < len) {
+			return {last, std::errc::value_too_large};
+		}
+
+		auto digit = [&](int index) {
+			return index >= 0 && index < value.count ? value.digits[index] : '0';
+		};
+
+		if (value.point <= 0) {
+			*first++ = '0';
+		} else {
+			int copied = value.point < value.count ? value.point : value.count;
+			std::memcpy(first, value.digits, copied);
+			std::memset(first + copied, '0', value.point - copied);
+			first += value.point;
+		}
+		if (precision > 0) {
+			*first++ = '.';
+			for (int i = 0; i < precision; i++) {
+				*first++ = digit(value.point + i);
+			}
+		}
+		return {first, std::errc{}};
+	}
+
+	/**
+	 * @brief Write digits in scientific notation, [-]d.ddde±dd
+	 *
+	 * @param first The beginning of the buffer
+	 * @param last The end of the buffer
+	 * @param value The digits to write, missing digits are written as zeros
+	 * @param precision The number of digits after the decimal point
+	 * @return The end of the written characters, or last and errc::value_too_large if the buffer is too small
+	 */
+	std::to_chars_result write_scientific(char *first, char *last, const Digits &value, int precision) {
+		int exponent = value.count > 0 ? value.point - 1 : 0;
+		int magnitude = exponent < 0 ? -exponent : exponent;
+		int exponent_len = magnitude >= 100 ? 3 : 2;
+		long len = 1 + (precision > 0 ? 1 + precision : 0) + 2 + exponent_len;
+		if (last - first < len) {
+			return {last, std::errc::value_too_large};
+		}
+
+		*first++ = value.count > 0 ? value.digits[0] : '0';
+		if (precision > 0) {
+			*first++ = '.';
+			for (int i = 1; i <= precision; i++) {
+				*first++ = i < value.count ? value.digits[i] : '0';
+			}
+		}
+		*first++ = 'e';
+		*first++ = exponent < 0 ? '-' : '+';
+		std::__detail::__write_decimal(first + exponent_len, magnitude);
+		if (magnitude < 10) {
+			*first = '0';
+		}
+		return {first + exponent_len, std::errc{}};
+	}
+
+	/**
+	 * @brief Write a number in hexadecimal scientific notation, [-]h.hhhp±d
+	 *
+	 * @tparam T The type of the number
+	 * @param first The beginning of the buffer
+	 * @param last The end of the buffer
+	 * @param ieee_mantissa The mantissa field of the number
+	 * @param ieee_exponent The exponent field of the number
+	 * @param precision The number of digits after the point, or negative for as many as needed
+	 * @return The end of the written characters, or last and errc::value_too_large if the buffer is too small
+	 */
+	template <typename T>
+	std::to_chars_result write_hex(char *first, char *last, uint64_t ieee_mantissa, uint32_t ieee_exponent,
+								   int precision) {
+		using Traits = FloatTraits<T>;
+
+		// the mantissa is shifted to fill whole hex digits, 13 for double and 6 for float
+		constexpr int DIGITS = (Traits::MANTISSA_BITS + 3) / 4;
+		uint64_t mantissa = ieee_mantissa << (DIGITS * 4 - Traits::MANTISSA_BITS);
+		uint32_t lead = ieee_exponent != 0;
+		int exponent = 0;
+		if (ieee_exponent != 0) {
+			exponent = static_cast<int>(ieee_exponent) - Traits::BIAS;
+		} else if (ieee_mantissa != 0) {
+			exponent = 1 - Traits::BIAS;
+		}
+
+		int digits = DIGITS;
+		if (precision < 0) {
+			while (digits > 0 && (mantissa & 0xf) == 0) {
+				mantissa >>= 4;
+				digits--;
+			}
+			precision = digits;
+		} else if (precision < DIGITS) {
+			int shift = (DIGITS - precision) * 4;
+			uint64_t remainder = mantissa & ((1ull << shift) - 1);
+			uint64_t half = 1ull << (shift - 1);
+			mantissa >>= shift;
+			// ties round to even, which is the leading digit when no digits are kept
+			bool odd = precision > 0 ? mantissa & 1 : lead & 1;
+			if (remainder > half || (remainder == half && odd)) {
+				mantissa++;
+			}
+			digits = precision;
+			if (mantissa >> (digits * 4)) {
+				lead++;
+				mantissa &= (1ull << (digits * 4)) - 1;
+			}
+		}
+
+		int magnitude = exponent < 0 ? -exponent : exponent;
+		long len = 1 + (precision > 0 ? 1 + precision : 0) + 2 + std::__detail::__count_digits(magnitude);
+		if (last - first < len) {
+			return {last, std::errc::value_too_large};
+		}
+
+		*first++ = std::__detail::__digit_chars[lead];
+		if (precision > 0) {
+			*first++ = '.';
+			for (int i = digits - 1; i >= 0; i--) {
+				*first++ = std::__detail::__digit_chars[(mantissa >> (i * 4)) & 0xf];
+			}
+			std::memset(first, '0', precision - digits);
+			first += precision - digits;
+		}
+		*first++ = 'p';
+		*first++ = exponent < 0 ? '-' : '+';
+		return std::to_chars(first, last, magnitude);
+	}
+#pragma endregion
+
+	/**
+	 * @brief Convert a floating point number to characters
+	 *
+	 * @tparam T The type of the number
+	 * @param first The beginning of the buffer
+	 * @param last The end of the buffer
+	 * @param value The number
+	 * @param fmt The format, or 0 for the shorter of fixed and scientific
+	 * @param precision The precision, or INT32_MIN for the shortest representation that round trips
+	 * @return The end of the written characters, or last and errc::value_too_large if the buffer is too small
+	 */
+	template <typename T>
+	std::to_chars_result to_chars(char *first, char *last, T value, std::chars_format fmt, int precision) {
+		using Traits = FloatTraits<T>;
+		using Bits = Traits::Bits;
+
+		constexpr int TOTAL_BITS = sizeof(Bits) * 8;
+		constexpr Bits EXPONENT_MASK = (Bits(1) << Traits::EXPONENT_BITS) - 1;
+
+		auto bits = __builtin_bit_cast(Bits, value);
+		bool negative = bits >> (TOTAL_BITS - 1);
+		Bits ieee_mantissa = bits & ((Bits(1) << Traits::MANTISSA_BITS) - 1);
+		uint32_t ieee_exponent = static_cast<uint32_t>((bits >> Traits::MANTISSA_BITS) & EXPONENT_MASK);
+		bool shortest = precision == INT32_MIN;
+
+		if (negative) {
+			if (first == last) {
+				return {last, std::errc::value_too_large};
+			}
+			*first++ = '-';
+		}
+
+		if (ieee_exponent == EXPONENT_MASK) {
+			auto str = ieee_mantissa ? "nan" : "inf";
+			if (last - first < 3) {
+				return {last, std::errc::value_too_large};
+			}
+			std::memcpy(first, str, 3);
+			return {first + 3, std::errc{}};
+		}
+
+		if (fmt == std::chars_format::hex) {
+			return write_hex<T>(first, last, ieee_mantissa, ieee_exponent, shortest ? -1 : precision);
+		}
+
+		Digits digits;
+		digits.count = 0;
+		digits.point = 1;
+		bool zero = ieee_mantissa == 0 && ieee_exponent == 0;
+
+		uint64_t m2 = ieee_mantissa;
+		int e2 = 1 - Traits::BIAS - Traits::MANTISSA_BITS;
+		if (ieee_exponent != 0) {
+			m2 |= uint64_t(1) << Traits::MANTISSA_BITS;
+			e2 = static_cast<int>(ieee_exponent) - Traits::BIAS - Traits::MANTISSA_BITS;
+		}
+
+		if (shortest) {
+			if (!zero) {
+				Decimal decimal = ryu(ieee_mantissa, ieee_exponent);
+				digits.count = std::__detail::__count_digits(decimal.mantissa);
+				std::__detail::__write_decimal(digits.digits + digits.count, decimal.mantissa);
+				digits.point = digits.count + decimal.exponent;
+			}
+
+			int exponent = digits.point - 1;
+			int fixed_precision = digits.count > digits.point ? digits.count - digits.point : 0;
+			int scientific_precision = digits.count > 1 ? digits.count - 1 : 0;
+			auto fixed = [&]() {
+				if (!zero && digits.point > digits.count) {
+					// a large integer is written exactly rather than padded with zeros
+					exact_digits(digits, m2, e2);
+				}
+				return write_fixed(first, last, digits, fixed_precision);
+			};
+			switch (fmt) {
+				case std::chars_format::fixed:
+					return fixed();
+				case std::chars_format::scientific:
+					return write_scientific(first, last, digits, scientific_precision);
+				case std::chars_format::general:
+					if (exponent >= -4 && exponent < 6) {
+						return fixed();
+					}
+					return write_scientific(first, last, digits, scientific_precision);
+				default: {
+					// the shorter of fixed and scientific, fixed on ties
+					int magnitude = exponent < 0 ? -exponent : exponent;
+					int scientific_len = digits.count + (digits.count > 1) + 2 + (magnitude >= 100 ? 3 : 2);
+					int fixed_len = digits.point <= 0				 ? 2 - digits.point + digits.count
+									: digits.point >= digits.count ? digits.point
+																   : digits.count + 1;
+					if (fixed_len <= scientific_len) {
+						return fixed();
+					}
+					return write_scientific(first, last, digits, scientific_precision);
+				}
+			}
+		}
+
+		if (precision < 0) {
+			precision = 6;
+		}
+
+		if (!zero) {
+			exact_digits(digits, m2, e2);
+		}
+
+		switch (fmt) {
+			case std::chars_format::fixed:
+				round_digits(digits, digits.point + precision);
+				return write_fixed(first, last, digits, precision);
+			case std::chars_format::scientific:
+				round_digits(digits, precision + 1);
+				return write_scientific(first, last, digits, precision);
+			default: {
+				// as printf %g, fixed when the exponent is in [-4, precision) and trailing zeros removed
+				int significant = precision == 0 ? 1 : precision;
+				round_digits(digits, significant);
+				while (digits.count > 0 && digits.digits[digits.count - 1] == '0') {
+					digits.count--;
+				}
+				int exponent = digits.count > 0 ? digits.point - 1 : 0;
+				if (exponent >= -4 && exponent < significant) {
+					return write_fixed(first, last, digits, digits.count > digits.point ? digits.count - digits.point : 0);
+				}
+				return write_scientific(first, last, digits, digits.count > 1 ? digits.count - 1 : 0);
+			}
+		}
+	}
+}
+
+namespace std {
+	to_chars_result to_chars(char *first, char *last, float value) {
+		return ::to_chars(first, last, value, chars_format{}, INT32_MIN);
+	}
+
+	to_chars_result to_chars(char *first, char *last, double value) {
+		return ::to_chars(first, last, value, chars_format{}, INT32_MIN);
+	}
+
+	to_chars_result to_chars(char *first, char *last, float value, chars_format fmt) {
+		return ::to_chars(first, last, value, fmt, INT32_MIN);
+	}
+
+	to_chars_result to_chars(char *first, char *last, double value, chars_format fmt) {
+		return ::to_chars(first, last, value, fmt, INT32_MIN);
+	}
+
+	to_chars_result to_chars(char *first, char *last, float value, chars_format fmt, int precision) {
+		// INT32_MIN selects the shortest form internally, any negative precision here means the default
+		return ::to_chars(first, last, value, fmt, precision == INT32_MIN ? -1 : precision);
+	}
+
+	to_chars_result to_chars(char *first, char *last, double value, chars_format fmt, int precision) {
+		// INT32_MIN selects the shortest form internally, any negative precision here means the default
+		return ::to_chars(first, last, value, fmt, precision == INT32_MIN ? -1 : precision);
+	}
+}
\ No newline at end of file
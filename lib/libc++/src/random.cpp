@@ -10,32 +10,118 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <bits/hash.h>
 #include <random>
 
 #include <kernel/arch/cpu.h>
 #include <kernel/debug.h>
 
 // TODO remove these
-#include <cstdlib>
 #include <kernel/arch/x86_64/time/rtc.h>
 
+namespace {
+	// RDRAND only fails if the DRNG is broken, RDSEED fails whenever its entropy pool runs dry
+	constexpr int RDRAND_RETRIES = 10;
+	constexpr int RDSEED_RETRIES = 100;
+
+	// the number of timing samples mixed into each fallback value
+	constexpr int JITTER_SAMPLES = 32;
+
+	bool detected = false;
+	bool has_rdseed = false;
+	bool has_rdrand = false;
+	uint64_t jitter_pool = 0;
+
+	/**
+	 * @brief Check for the hardware entropy sources, cpuid is slow (and traps
+	 * under a hypervisor) so this is only done once
+	 *
+	 */
+	void detect(void) {
+		has_rdseed = CPU::has_feature(CPU::Feature::RDSEED);
+		has_rdrand = CPU::has_feature(CPU::Feature::RDRAND);
+		if (!has_rdseed && !has_rdrand) {
+			Debug::log_warning("RDSEED and RDRAND not supported, using TSC jitter");
+		}
+
+		// TODO add DateTime.epoch() or something instead of this
+		auto time = Time::RTC::now();
+		jitter_pool = *reinterpret_cast<uint64_t *>(&time) ^ CPU::get_tsc();
+		detected = true;
+	}
+
+	/**
+	 * @brief Read the hardware seed generator
+	 *
+	 * @param value The random value
+	 * @return true if the read succeeded, false if the entropy pool stayed empty
+	 */
+	bool rdseed(unsigned int &value) {
+		for (int i = 0; i < RDSEED_RETRIES; i++) {
+			bool ok;
+			asm volatile("rdseed %0" : "=r"(value), "=@ccc"(ok));
+			if (ok) {
+				return true;
+			}
+			CPU::pause();
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Read the hardware random number generator
+	 *
+	 * @param value The random value
+	 * @return true if the read succeeded, false if the generator is broken
+	 */
+	bool rdrand(unsigned int &value) {
+		for (int i = 0; i < RDRAND_RETRIES; i++) {
+			bool ok;
+			asm volatile("rdrand %0" : "=r"(value), "=@ccc"(ok));
+			if (ok) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Generate a value from the timing jitter of a short data dependent
+	 * loop, which varies with cache, pipeline and interrupt state
+	 *
+	 * @return The random value
+	 */
+	unsigned int jitter(void) {
+		uint64_t pool = jitter_pool;
+		for (int i = 0; i < JITTER_SAMPLES; i++) {
+			uint64_t start = CPU::get_tsc();
+			volatile uint64_t sink = pool;
+			for (uint64_t j = 0; j < (start & 0xF) + 1; j++) {
+				sink = sink * 0x9e3779b97f4a7c15 + j;
+			}
+			uint64_t delta = CPU::get_tsc() - start;
+			pool = std::__detail::__hash_mix(pool ^ delta ^ sink, 0xa0761d6478bd642f);
+		}
+		jitter_pool = pool;
+		return static_cast<unsigned int>(pool ^ (pool >> 32));
+	}
+}
+
 namespace std {
 	unsigned int random_device::operator()(void) {
 		// TODO move to <kernel/random.h> or something
-		if (CPU::has_feature(CPU::Feature::RDSEED)) {
-			unsigned int value;
-			asm volatile("1: rdseed %0; jnc 1b" : "=r"(value));
+		if (!detected) {
+			detect();
+		}
+
+		// RDRAND is still cryptographically secure while RDSEED is starved
+		unsigned int value;
+		if (has_rdseed && rdseed(value)) {
 			return value;
-		} else if (CPU::has_feature(CPU::Feature::RDRAND)) {
-			unsigned int value;
-			asm volatile("1: rdrand %0; jnc 1b" : "=r"(value));
+		}
+		if (has_rdrand && rdrand(value)) {
 			return value;
-		} else {
-			Debug::log_warning("RDSEED and RDRAND not supported, using rand()");
-			// TODO add DateTime.epoch() or something instead of this
-			auto time = Time::RTC::now();
-			srand(*reinterpret_cast<uint64_t *>(&time) ^ rand());
-			return rand();
 		}
+		return jitter();
 	}
 }
\ No newline at end of file
@@ -23,6 +23,9 @@
 #include <unistd.h>
 #include <wchar.h>
 
+#include <charconv>
+#include <type_traits>
+
 #define LEFT 1
 #define PLUS 2
 #define SPACE 4
@@ -43,8 +46,6 @@
 #define _STDOUT 1
 #define _STDERR 2
 
-static const char *const _digits = "0123456789ABCDEF";
-
 static FILE _stdin;
 static FILE _stdout;
 static FILE _stderr;
@@ -73,43 +74,29 @@ extern "C" void __stdio_init(void) {
 }
 
 /**
- * @brief Convert an integer to a string
+ * @brief Convert the magnitude of an integer to a string
  *
  * @tparam T The type of the integer
  * @param value The integer to convert
  * @param str The string buffer to write to
+ * @param size The size of the string buffer
  * @param base The base to convert to
  * @param uppercase Whether to use uppercase letters
  * @return The number of characters written
  */
 template <typename T>
-static size_t __vtoa(T value, char *str, int base, bool uppercase) {
-	char lower = uppercase ? 0 : 32;
-	char *ptr = str;
-	size_t count = 0;
-	T tmpv;
-
-	if (value < 0) {
-		value = -value;
-	}
-
-	do {
-		count++;
-		tmpv = value;
-		value /= base;
-		*ptr++ = _digits[(tmpv - value * base)] | lower;
-	} while (value);
-	*ptr-- = '\0';
-
-	char *tmpp = str;
-	char tmpc;
-	while (tmpp < ptr) {
-		tmpc = *ptr;
-		*ptr-- = *tmpp;
-		*tmpp++ = tmpc;
+static size_t __vtoa(T value, char *str, size_t size, int base, bool uppercase) {
+	// the sign is written by the caller, and the magnitude of the most negative value fits in U
+	using U = std::make_unsigned_t<T>;
+	U magnitude = value < 0 ? U(0) - static_cast<U>(value) : static_cast<U>(value);
+
+	char *end = std::to_chars(str, str + size, magnitude, base).ptr;
+	if (uppercase) {
+		for (char *ptr = str; ptr < end; ptr++) {
+			*ptr = toupper(*ptr);
+		}
 	}
-
-	return count;
+	return end - str;
 }
 
 /**
@@ -121,11 +108,16 @@ static size_t __vtoa(T value, char *str, int base, bool uppercase) {
  * @return The number of characters written, or EOF on failure
  */
 static int __pad(FILE *stream, char c, int num) {
-	int i;
-	for (i = 0; i < num; i++) {
-		if (fputc(c, stream) == EOF) {
+	char chunk[32];
+	memset(chunk, c, sizeof(chunk));
+
+	int i = 0;
+	while (i < num) {
+		size_t size = num - i < static_cast<int>(sizeof(chunk)) ? num - i : sizeof(chunk);
+		if (fwrite(chunk, sizeof(char), size, stream) != size) {
 			return EOF;
 		}
+		i += size;
 	}
 	return i;
 }
@@ -192,11 +184,13 @@ size_t fwrite(const void *ptr, size_t size, size_t num, FILE *stream) {
 	size_t count = 0;
 	const char *buffer = reinterpret_cast<const char *>(ptr);
 
-	while (len > 0) {
+	// copy as much as fits in the buffer at a time, stopping after each newline when line buffered
+	while (count < len) {
 		if (stream->_write_ptr >= stream->_write_end) [[unlikely]] {
 			if (fileno(stream) == _STRBUF) {
+				// the rest is discarded but counted as written, as snprintf requires
 				stream->_flags |= _IOEOF;
-				return len;
+				return num;
 			}
 			if (fflush(stream) == EOF) {
 				// propagate errno from fflush
@@ -204,19 +198,32 @@ size_t fwrite(const void *ptr, size_t size, size_t num, FILE *stream) {
 			}
 		}
 
+		size_t chunk = len - count;
+		size_t space = stream->_write_end - stream->_write_ptr;
+		if (chunk > space) {
+			chunk = space;
+		}
+		bool line_end = false;
+		if (stream->_flags & _IOLBF) {
+			auto newline = static_cast<const char *>(memchr(buffer + count, '\n', chunk));
+			if (newline) {
+				chunk = newline - (buffer + count) + 1;
+				line_end = true;
+			}
+		}
+
 		if (!feof(stream)) [[likely]] {
-			*stream->_write_ptr++ = *buffer;
+			memcpy(stream->_write_ptr, buffer + count, chunk);
+			stream->_write_ptr += chunk;
 		}
-		if ((stream->_flags & _IOLBF) && *buffer == '\n') {
+		count += chunk;
+
+		if (line_end) {
 			if (fflush(stream) == EOF) {
 				// propagate errno from fflush
-				return count / size;
+				return (count - chunk) / size;
 			}
 		}
-
-		buffer++;
-		count++;
-		len--;
 	}
 
 	return count / size;
@@ -403,6 +410,102 @@ int vsprintf(char *str, const char *format, va_list ap) {
 	return count;
 }
 
+/**
+ * @brief Write a floating point number to a file stream
+ *
+ * @param stream The file stream to write to
+ * @param value The number to write
+ * @param spec The conversion specifier, one of f, e, g or a
+ * @param flags The format flags
+ * @param width The minimum field width
+ * @param precision The precision, or -1 for the default
+ * @return The number of characters written
+ */
+static int __fputf(FILE *stream, double value, char spec, int flags, int width, int precision) {
+	// large enough for DBL_MAX in fixed notation with MAX_PRECISION digits after the point
+	constexpr int MAX_PRECISION = 180;
+	char buffer[512];
+
+	std::chars_format fmt = std::chars_format::hex;
+	switch (spec) {
+		case 'f':
+			fmt = std::chars_format::fixed;
+			break;
+		case 'e':
+			fmt = std::chars_format::scientific;
+			break;
+		case 'g':
+			fmt = std::chars_format::general;
+			break;
+	}
+	if (precision < 0 && fmt != std::chars_format::hex) {
+		precision = 6;
+	}
+
+	// TODO digits past MAX_PRECISION are written as zeros rather than converted exactly
+	int extra = 0;
+	if (precision > MAX_PRECISION) {
+		extra = fmt == std::chars_format::general ? 0 : precision - MAX_PRECISION;
+		precision = MAX_PRECISION;
+	}
+
+	// with no precision %a is the shortest exact representation
+	auto result = precision < 0 ? std::to_chars(buffer, buffer + sizeof(buffer), value, fmt)
+								: std::to_chars(buffer, buffer + sizeof(buffer), value, fmt, precision);
+	char *digits = buffer;
+	char *end = result.ptr;
+
+	bool negative = *digits == '-';
+	if (negative) {
+		digits++;
+	}
+	bool finite = isdigit(*digits);
+	if (flags & UPPERCASE) {
+		for (char *ptr = digits; ptr < end; ptr++) {
+			*ptr = toupper(*ptr);
+		}
+	}
+
+	// extra zeros go before the exponent
+	char *split = end;
+	if (!finite) {
+		extra = 0;
+	} else if (fmt == std::chars_format::scientific || fmt == std::chars_format::hex) {
+		while (split > digits && (*(split - 1) | 32) != 'e' && (*(split - 1) | 32) != 'p') {
+			split--;
+		}
+		split--;
+	}
+
+	// TODO alternate form (#)
+	char sign = negative ? '-' : (flags & PLUS) ? '+' : (flags & SPACE) ? ' ' : 0;
+	bool prefix = fmt == std::chars_format::hex && finite;
+	bool zeros = (flags & ZEROS) && !(flags & LEFT) && finite;
+	width -= (end - digits) + extra + (sign != 0) + (prefix ? 2 : 0);
+
+	int count = 0;
+	if (!(flags & LEFT) && !zeros) {
+		count += __pad(stream, ' ', width);
+	}
+	if (sign) {
+		count += fputc(sign, stream) != EOF;
+	}
+	if (prefix) {
+		count += fputc('0', stream) != EOF;
+		count += fputc('x' - (flags & UPPERCASE), stream) != EOF;
+	}
+	if (zeros) {
+		count += __pad(stream, '0', width);
+	}
+	count += fwrite(digits, sizeof(char), split - digits, stream);
+	count += __pad(stream, '0', extra);
+	count += fwrite(split, sizeof(char), end - split, stream);
+	if (flags & LEFT) {
+		count += __pad(stream, ' ', width);
+	}
+	return count;
+}
+
 int vfprintf(FILE *stream, const char *format, va_list ap) {
 	char buffer[32];
 	size_t count = 0;
@@ -415,9 +518,13 @@ int vfprintf(FILE *stream, const char *format, va_list ap) {
 	int precision;
 
 	for (size_t i = 0; format[i] != '\0'; i++) {
-		// print non-format characters
+		// print non-format characters up to the next conversion
 		if (format[i] != '%') [[likely]] {
-			count += fputc(format[i], stream) != EOF;
+			size_t start = i;
+			while (format[i + 1] != '\0' && format[i + 1] != '%') {
+				i++;
+			}
+			count += fwrite(&format[start], sizeof(char), i - start + 1, stream);
 			continue;
 		}
 		i++;
@@ -559,9 +666,7 @@ int vfprintf(FILE *stream, const char *format, va_list ap) {
 					if (!(flags & LEFT)) {
 						count += __pad(stream, ' ', width);
 					}
-					for (int i = 0; i < len; i++) {
-						count += fputc(s[i], stream) != EOF;
-					}
+					count += fwrite(s, sizeof(char), len, stream);
 				}
 				if (flags & LEFT) {
 					count += __pad(stream, ' ', width);
@@ -597,6 +702,19 @@ int vfprintf(FILE *stream, const char *format, va_list ap) {
 				base = HEXADECIMAL;
 				break;
 			}
+			case 'F':
+			case 'E':
+			case 'G':
+			case 'A':
+				flags |= UPPERCASE;
+				[[fallthrough]];
+			case 'f':
+			case 'e':
+			case 'g':
+			case 'a': {
+				count += __fputf(stream, va_arg(ap, double), format[i] | 32, flags, width, precision);
+				continue;
+			}
 			case 'p': {
 				flags |= PREFIX | ZEROS | POINTER;
 				base = HEXADECIMAL;
@@ -636,31 +754,31 @@ int vfprintf(FILE *stream, const char *format, va_list ap) {
 		if (flags & SIGNED) {
 			switch (size) {
 				case sizeof(int8_t):
-					len = __vtoa(static_cast<int8_t>(value), buffer, base, flags & UPPERCASE);
+					len = __vtoa(static_cast<int8_t>(value), buffer, sizeof(buffer), base, flags & UPPERCASE);
 					break;
 				case sizeof(int16_t):
-					len = __vtoa(static_cast<int16_t>(value), buffer, base, flags & UPPERCASE);
+					len = __vtoa(static_cast<int16_t>(value), buffer, sizeof(buffer), base, flags & UPPERCASE);
 					break;
 				case sizeof(int32_t):
-					len = __vtoa(static_cast<int32_t>(value), buffer, base, flags & UPPERCASE);
+					len = __vtoa(static_cast<int32_t>(value), buffer, sizeof(buffer), base, flags & UPPERCASE);
 					break;
 				case sizeof(int64_t):
-					len = __vtoa(static_cast<int64_t>(value), buffer, base, flags & UPPERCASE);
+					len = __vtoa(static_cast<int64_t>(value), buffer, sizeof(buffer), base, flags & UPPERCASE);
 					break;
 			}
 		} else {
 			switch (size) {
 				case sizeof(uint8_t):
-					len = __vtoa(static_cast<uint8_t>(value), buffer, base, flags & UPPERCASE);
+					len = __vtoa(static_cast<uint8_t>(value), buffer, sizeof(buffer), base, flags & UPPERCASE);
 					break;
 				case sizeof(uint16_t):
-					len = __vtoa(static_cast<uint16_t>(value), buffer, base, flags & UPPERCASE);
+					len = __vtoa(static_cast<uint16_t>(value), buffer, sizeof(buffer), base, flags & UPPERCASE);
 					break;
 				case sizeof(uint32_t):
-					len = __vtoa(static_cast<uint32_t>(value), buffer, base, flags & UPPERCASE);
+					len = __vtoa(static_cast<uint32_t>(value), buffer, sizeof(buffer), base, flags & UPPERCASE);
 					break;
 				case sizeof(uint64_t):
-					len = __vtoa(static_cast<uint64_t>(value), buffer, base, flags & UPPERCASE);
+					len = __vtoa(static_cast<uint64_t>(value), buffer, sizeof(buffer), base, flags & UPPERCASE);
 					break;
 			}
 		}
@@ -720,9 +838,7 @@ int vfprintf(FILE *stream, const char *format, va_list ap) {
 			count += __pad(stream, '0', width);
 		}
 		count += __pad(stream, '0', precision);
-		for (int i = 0; i < len; i++) {
-			count += fputc(buffer[i], stream) != EOF;
-		}
+		count += fwrite(buffer, sizeof(char), len, stream);
 		if (flags & LEFT) {
 			count += __pad(stream, ' ', width);
 		}
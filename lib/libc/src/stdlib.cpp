@@ -137,4 +137,168 @@ int rand_r(unsigned int *seed) {
 
 void srand(unsigned int seed) {
 	_seed = seed;
+}
+
+// partitions smaller than this are insertion sorted by qsort
+#define QSORT_INSERTION_THRESHOLD 16
+
+/**
+ * @brief Swap two elements of an array
+ *
+ * @param a The first element
+ * @param b The second element
+ * @param size The size of an element
+ */
+static inline void _qsort_swap(char *a, char *b, size_t size) {
+	if (a == b) {
+		return;
+	}
+	while (size >= sizeof(uint64_t)) {
+		uint64_t tmp;
+		memcpy(&tmp, a, sizeof(uint64_t));
+		memcpy(a, b, sizeof(uint64_t));
+		memcpy(b, &tmp, sizeof(uint64_t));
+		a += sizeof(uint64_t);
+		b += sizeof(uint64_t);
+		size -= sizeof(uint64_t);
+	}
+	while (size--) {
+		char tmp = *a;
+		*a++ = *b;
+		*b++ = tmp;
+	}
+}
+
+/**
+ * @brief Insertion sort for small partitions
+ *
+ * @param base The start of the array
+ * @param count The number of elements
+ * @param size The size of an element
+ * @param compare The comparison function
+ */
+static void _qsort_insertion(char *base, size_t count, size_t size, int (*compare)(const void *, const void *)) {
+	for (size_t i = 1; i < count; i++) {
+		for (char *cur = base + i * size; cur > base && compare(cur - size, cur) > 0; cur -= size) {
+			_qsort_swap(cur - size, cur, size);
+		}
+	}
+}
+
+/**
+ * @brief Sift an element down a max heap
+ *
+ * @param base The start of the heap
+ * @param count The number of elements in the heap
+ * @param pos The index of the element to sift down
+ * @param size The size of an element
+ * @param compare The comparison function
+ */
+static void _qsort_sift(char *base, size_t count, size_t pos, size_t size, int (*compare)(const void *, const void *)) {
+	while (true) {
+		size_t largest = pos;
+		size_t left = 2 * pos + 1;
+		size_t right = left + 1;
+		if (left < count && compare(base + left * size, base + largest * size) > 0) {
+			largest = left;
+		}
+		if (right < count && compare(base + right * size, base + largest * size) > 0) {
+			largest = right;
+		}
+		if (largest == pos) {
+			return;
+		}
+		_qsort_swap(base + pos * size, base + largest * size, size);
+		pos = largest;
+	}
+}
+
+/**
+ * @brief Heap sort, used when quicksort keeps picking bad pivots
+ *
+ * @param base The start of the array
+ * @param count The number of elements
+ * @param size The size of an element
+ * @param compare The comparison function
+ */
+static void _qsort_heap(char *base, size_t count, size_t size, int (*compare)(const void *, const void *)) {
+	for (size_t i = count / 2; i-- > 0;) {
+		_qsort_sift(base, count, i, size, compare);
+	}
+	for (size_t end = count - 1; end > 0; end--) {
+		_qsort_swap(base, base + end * size, size);
+		_qsort_sift(base, end, 0, size, compare);
+	}
+}
+
+/**
+ * @brief Introsort, quicksort with a median of three pivot that falls back to heap sort after too many bad partitions
+ *
+ * @param base The start of the array
+ * @param count The number of elements
+ * @param size The size of an element
+ * @param compare The comparison function
+ * @param depth The number of partitions allowed before falling back to heap sort
+ */
+static void _qsort_intro(char *base, size_t count, size_t size, int (*compare)(const void *, const void *),
+						 int depth) {
+	while (count > QSORT_INSERTION_THRESHOLD) {
+		if (depth-- == 0) {
+			_qsort_heap(base, count, size, compare);
+			return;
+		}
+
+		// sort the first, middle and last elements, then use the middle one as the pivot
+		char *first = base;
+		char *middle = base + (count / 2) * size;
+		char *last = base + (count - 1) * size;
+		if (compare(middle, first) < 0) {
+			_qsort_swap(middle, first, size);
+		}
+		if (compare(last, middle) < 0) {
+			_qsort_swap(last, middle, size);
+			if (compare(middle, first) < 0) {
+				_qsort_swap(middle, first, size);
+			}
+		}
+		_qsort_swap(first, middle, size);
+
+		// hoare partition around *first, the sorted last element stops the left scan
+		char *left = first;
+		char *right = last + size;
+		while (true) {
+			do {
+				left += size;
+			} while (left < last && compare(left, first) < 0);
+			do {
+				right -= size;
+			} while (compare(first, right) < 0);
+			if (left >= right) {
+				break;
+			}
+			_qsort_swap(left, right, size);
+		}
+		_qsort_swap(first, right, size);
+
+		// recurse into the smaller side to bound the stack depth
+		size_t left_count = (right - base) / size;
+		size_t right_count = count - left_count - 1;
+		if (left_count < right_count) {
+			_qsort_intro(base, left_count, size, compare, depth);
+			base = right + size;
+			count = right_count;
+		} else {
+			_qsort_intro(right + size, right_count, size, compare, depth);
+			count = left_count;
+		}
+	}
+	_qsort_insertion(base, count, size, compare);
+}
+
+void qsort(void *base, size_t count, size_t size, int (*compare)(const void *, const void *)) {
+	if (count < 2 || size == 0) {
+		return;
+	}
+	int depth = 2 * (63 - __builtin_clzll(count));
+	_qsort_intro(static_cast<char *>(base), count, size, compare, depth);
 }
\ No newline at end of file
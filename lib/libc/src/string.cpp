@@ -11,108 +11,754 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-void *memccpy(void *dest, const void *src, int c, size_t n) {
-	for (size_t i = 0; i < n; i++) {
-		static_cast<char *>(dest)[i] = static_cast<const char *>(src)[i];
-		if (static_cast<const char *>(src)[i] == c) {
-			return static_cast<char *>(dest) + i + 1;
+#ifdef __is_kernel
+#include <kernel/arch/cpu.h>
+#endif
+
+// unaligned views used to move data through registers
+typedef uint64_t __u64 __attribute__((may_alias, aligned(1)));
+typedef uint32_t __u32 __attribute__((may_alias, aligned(1)));
+typedef long long __v2di __attribute__((vector_size(16), may_alias, aligned(1)));
+typedef long long __v2di_aligned __attribute__((vector_size(16), may_alias));
+typedef char __v16qi __attribute__((vector_size(16), may_alias, aligned(1)));
+typedef char __v16qi_aligned __attribute__((vector_size(16), may_alias));
+
+// aligned 16 byte loads never cross this boundary, so can safely read past the end of a string
+#define PAGE_BOUNDARY 4096
+
+// copies and fills of at least this many bytes use non-temporal stores, as they would evict the whole cache
+#define NON_TEMPORAL_THRESHOLD (1024 * 1024)
+
+// without FSRM, rep movsb/stosb has a startup cost that only pays off for larger sizes
+#define REP_THRESHOLD 2048
+
+typedef void (*CopyFunc)(char *dest, const char *src, size_t n);
+typedef void (*FillFunc)(char *dest, uint64_t pattern, size_t n);
+
+// stop GCC from turning the loops below back into calls to memcpy/memset
+#pragma GCC push_options
+#pragma GCC optimize("no-tree-loop-distribute-patterns")
+
+// the fallbacks are used before SSE is enabled, so must not touch the SSE registers
+#pragma GCC push_options
+#pragma GCC target("general-regs-only")
+
+/**
+ * @brief Copy fewer than 16 bytes, all bytes are loaded before any are stored so any overlap is handled
+ *
+ * @param dest The destination buffer
+ * @param src The source buffer
+ * @param n The number of bytes to copy
+ */
+static void __copy_small(char *dest, const char *src, size_t n) {
+	if (n >= 8) {
+		uint64_t head = *reinterpret_cast<const __u64 *>(src);
+		uint64_t tail = *reinterpret_cast<const __u64 *>(src + n - 8);
+		*reinterpret_cast<__u64 *>(dest) = head;
+		*reinterpret_cast<__u64 *>(dest + n - 8) = tail;
+	} else if (n >= 4) {
+		uint32_t head = *reinterpret_cast<const __u32 *>(src);
+		uint32_t tail = *reinterpret_cast<const __u32 *>(src + n - 4);
+		*reinterpret_cast<__u32 *>(dest) = head;
+		*reinterpret_cast<__u32 *>(dest + n - 4) = tail;
+	} else if (n > 0) {
+		char first = src[0];
+		char middle = src[n / 2];
+		char last = src[n - 1];
+		dest[0] = first;
+		dest[n / 2] = middle;
+		dest[n - 1] = last;
+	}
+}
+
+/**
+ * @brief Fill fewer than 16 bytes
+ *
+ * @param dest The destination buffer
+ * @param pattern The byte to fill with, repeated 8 times
+ * @param n The number of bytes to fill
+ */
+static void __fill_small(char *dest, uint64_t pattern, size_t n) {
+	if (n >= 8) {
+		*reinterpret_cast<__u64 *>(dest) = pattern;
+		*reinterpret_cast<__u64 *>(dest + n - 8) = pattern;
+	} else if (n >= 4) {
+		*reinterpret_cast<__u32 *>(dest) = static_cast<uint32_t>(pattern);
+		*reinterpret_cast<__u32 *>(dest + n - 4) = static_cast<uint32_t>(pattern);
+	} else {
+		for (size_t i = 0; i < n; i++) {
+			dest[i] = static_cast<char>(pattern);
 		}
 	}
+}
 
-	return nullptr;
+/**
+ * @brief Copy forwards 8 bytes at a time with rep movsq
+ *
+ * @param dest The destination buffer
+ * @param src The source buffer
+ * @param n The number of bytes to copy
+ *
+ * @note Handles overlapping buffers where dest < src
+ */
+static void __copy_movsq(char *dest, const char *src, size_t n) {
+	if (n < 16) {
+		__copy_small(dest, src, n);
+		return;
+	}
+
+	// loaded first, as an overlapping copy may overwrite it
+	uint64_t tail = *reinterpret_cast<const __u64 *>(src + n - 8);
+	auto out = dest;
+	size_t count = n / 8;
+	asm volatile("rep movsq" : "+D"(out), "+S"(src), "+c"(count) : : "memory");
+	*reinterpret_cast<__u64 *>(dest + n - 8) = tail;
 }
 
-void *memchr(const void *buf, int c, size_t n) {
+/**
+ * @brief Copy backwards 8 bytes at a time
+ *
+ * @param dest The destination buffer
+ * @param src The source buffer
+ * @param n The number of bytes to copy
+ *
+ * @note Handles overlapping buffers where dest > src
+ */
+static void __copy_backward_u64(char *dest, const char *src, size_t n) {
+	if (n < 16) {
+		__copy_small(dest, src, n);
+		return;
+	}
+
+	uint64_t head = *reinterpret_cast<const __u64 *>(src);
+	for (; n >= 16; n -= 8) {
+		*reinterpret_cast<__u64 *>(dest + n - 8) = *reinterpret_cast<const __u64 *>(src + n - 8);
+	}
+	*reinterpret_cast<__u64 *>(dest + n - 8) = *reinterpret_cast<const __u64 *>(src + n - 8);
+	*reinterpret_cast<__u64 *>(dest) = head;
+}
+
+/**
+ * @brief Fill 8 bytes at a time with rep stosq
+ *
+ * @param dest The destination buffer
+ * @param pattern The byte to fill with, repeated 8 times
+ * @param n The number of bytes to fill
+ */
+static void __fill_stosq(char *dest, uint64_t pattern, size_t n) {
+	if (n < 16) {
+		__fill_small(dest, pattern, n);
+		return;
+	}
+
+	auto out = dest;
+	size_t count = n / 8;
+	asm volatile("rep stosq" : "+D"(out), "+c"(count) : "a"(pattern) : "memory");
+	*reinterpret_cast<__u64 *>(dest + n - 8) = pattern;
+}
+
+/**
+ * @brief Find the length of a string one byte at a time
+ *
+ * @param str The string
+ * @return The length of the string
+ */
+static size_t __strlen_bytes(const char *str) {
+	size_t len = 0;
+	while (str[len]) {
+		len++;
+	}
+	return len;
+}
+
+/**
+ * @brief Find the length of a string one byte at a time, up to a maximum
+ *
+ * @param str The string
+ * @param maxlen The maximum length
+ * @return The length of the string, or maxlen if it is longer
+ */
+static size_t __strnlen_bytes(const char *str, size_t maxlen) {
+	size_t len = 0;
+	while (len < maxlen && str[len]) {
+		len++;
+	}
+	return len;
+}
+
+/**
+ * @brief Find a byte in a buffer one byte at a time
+ *
+ * @param buf The buffer
+ * @param c The byte to find
+ * @param n The size of the buffer
+ * @return A pointer to the byte, or nullptr if not found
+ */
+static void *__memchr_bytes(const void *buf, int c, size_t n) {
+	auto bytes = static_cast<const unsigned char *>(buf);
 	for (size_t i = 0; i < n; i++) {
-		if (static_cast<const char *>(buf)[i] == c) {
-			return const_cast<char *>(static_cast<const char *>(buf)) + i;
+		if (bytes[i] == static_cast<unsigned char>(c)) {
+			return const_cast<unsigned char *>(bytes + i);
 		}
 	}
-
 	return nullptr;
 }
 
-int memcmp(const void *buf1, const void *buf2, size_t n) {
-	for (size_t i = 0; i < n; i++) {
-		if (static_cast<const char *>(buf1)[i] < static_cast<const char *>(buf2)[i]) {
-			return -1;
-		} else if (static_cast<const char *>(buf1)[i] > static_cast<const char *>(buf2)[i]) {
-			return 1;
+/**
+ * @brief Find a character in a string one byte at a time
+ *
+ * @param str The string
+ * @param c The character to find, may be the terminator
+ * @return A pointer to the character, or nullptr if not found
+ */
+static char *__strchr_bytes(const char *str, int c) {
+	while (*str != static_cast<char>(c)) {
+		if (*str == '\0') {
+			return nullptr;
 		}
+		str++;
 	}
+	return const_cast<char *>(str);
+}
 
+/**
+ * @brief Compare two buffers one byte at a time
+ *
+ * @param buf1 The first buffer
+ * @param buf2 The second buffer
+ * @param n The number of bytes to compare
+ * @return The difference between the first differing bytes, or 0 if equal
+ */
+static int __memcmp_bytes(const void *buf1, const void *buf2, size_t n) {
+	auto bytes1 = static_cast<const unsigned char *>(buf1);
+	auto bytes2 = static_cast<const unsigned char *>(buf2);
+	for (size_t i = 0; i < n; i++) {
+		if (bytes1[i] != bytes2[i]) {
+			return bytes1[i] - bytes2[i];
+		}
+	}
 	return 0;
 }
 
-void *memcpy(void *dest, const void *src, size_t n) {
+/**
+ * @brief Compare two strings one byte at a time, up to a maximum length
+ *
+ * @param str1 The first string
+ * @param str2 The second string
+ * @param n The maximum number of characters to compare
+ * @return The difference between the first differing characters, or 0 if equal
+ */
+static int __strncmp_bytes(const char *str1, const char *str2, size_t n) {
 	for (size_t i = 0; i < n; i++) {
-		static_cast<char *>(dest)[i] = static_cast<const char *>(src)[i];
+		auto c1 = static_cast<unsigned char>(str1[i]);
+		auto c2 = static_cast<unsigned char>(str2[i]);
+		if (c1 != c2 || c1 == '\0') {
+			return c1 - c2;
+		}
 	}
+	return 0;
+}
 
-	return dest;
+/**
+ * @brief Compare two strings one byte at a time
+ *
+ * @param str1 The first string
+ * @param str2 The second string
+ * @return The difference between the first differing characters, or 0 if equal
+ */
+static int __strcmp_bytes(const char *str1, const char *str2) {
+	return __strncmp_bytes(str1, str2, SIZE_MAX);
 }
 
-void *memmove(void *dest, const void *src, size_t n) {
-	if (dest < src) {
-		for (size_t i = 0; i < n; i++) {
-			static_cast<char *>(dest)[i] = static_cast<const char *>(src)[i];
-		}
-	} else {
-		for (size_t i = n; i > 0; i--) {
-			static_cast<char *>(dest)[i - 1] = static_cast<const char *>(src)[i - 1];
-		}
+#pragma GCC pop_options
+
+/**
+ * @brief Copy forwards with non-temporal stores, which bypass the cache
+ *
+ * @param dest The destination buffer
+ * @param src The source buffer
+ * @param n The number of bytes to copy, at least 16
+ *
+ * @note Handles overlapping buffers where dest < src
+ */
+static void __copy_non_temporal(char *dest, const char *src, size_t n) {
+	// loaded first and stored last, as an overlapping copy may overwrite them
+	auto head = *reinterpret_cast<const __v2di *>(src);
+	auto tail = *reinterpret_cast<const __v2di *>(src + n - 16);
+
+	// non-temporal stores must be aligned, the unaligned head covers the bytes skipped
+	size_t offset = 16 - (reinterpret_cast<uintptr_t>(dest) & 15);
+	for (; offset + 64 <= n; offset += 64) {
+		const __v2di *in = reinterpret_cast<const __v2di *>(src + offset);
+		__v2di_aligned *out = reinterpret_cast<__v2di_aligned *>(dest + offset);
+		auto a = in[0], b = in[1], c = in[2], d = in[3];
+		__builtin_ia32_movntdq(&out[0], a);
+		__builtin_ia32_movntdq(&out[1], b);
+		__builtin_ia32_movntdq(&out[2], c);
+		__builtin_ia32_movntdq(&out[3], d);
 	}
+	for (; offset + 16 <= n; offset += 16) {
+		__builtin_ia32_movntdq(reinterpret_cast<__v2di_aligned *>(dest + offset), *reinterpret_cast<const __v2di *>(src + offset));
+	}
+	__builtin_ia32_sfence();
 
-	return dest;
+	*reinterpret_cast<__v2di *>(dest) = head;
+	*reinterpret_cast<__v2di *>(dest + n - 16) = tail;
 }
 
-void *memset(void *buf, int value, size_t n) {
-	for (size_t i = 0; i < n; i++) {
-		static_cast<char *>(buf)[i] = value;
+/**
+ * @brief Copy forwards 16 bytes at a time with SSE2
+ *
+ * @param dest The destination buffer
+ * @param src The source buffer
+ * @param n The number of bytes to copy
+ *
+ * @note Handles overlapping buffers where dest < src
+ */
+static void __copy_sse2(char *dest, const char *src, size_t n) {
+	if (n < 16) {
+		__copy_small(dest, src, n);
+		return;
+	}
+	if (n >= NON_TEMPORAL_THRESHOLD) {
+		__copy_non_temporal(dest, src, n);
+		return;
 	}
 
-	return buf;
+	// loaded first, as an overlapping copy may overwrite it
+	auto tail = *reinterpret_cast<const __v2di *>(src + n - 16);
+	size_t offset = 0;
+	for (; offset + 64 <= n; offset += 64) {
+		const __v2di *in = reinterpret_cast<const __v2di *>(src + offset);
+		__v2di *out = reinterpret_cast<__v2di *>(dest + offset);
+		auto a = in[0], b = in[1], c = in[2], d = in[3];
+		out[0] = a;
+		out[1] = b;
+		out[2] = c;
+		out[3] = d;
+	}
+	for (; offset + 16 <= n; offset += 16) {
+		*reinterpret_cast<__v2di *>(dest + offset) = *reinterpret_cast<const __v2di *>(src + offset);
+	}
+	*reinterpret_cast<__v2di *>(dest + n - 16) = tail;
 }
 
-size_t strlen(const char *str) {
-	size_t len = 0;
-	while (str[len]) {
-		len++;
+/**
+ * @brief Copy backwards 16 bytes at a time with SSE2
+ *
+ * @param dest The destination buffer
+ * @param src The source buffer
+ * @param n The number of bytes to copy
+ *
+ * @note Handles overlapping buffers where dest > src
+ */
+static void __copy_backward_sse2(char *dest, const char *src, size_t n) {
+	if (n < 16) {
+		__copy_small(dest, src, n);
+		return;
 	}
-	return len;
+
+	auto head = *reinterpret_cast<const __v2di *>(src);
+	for (; n >= 32; n -= 16) {
+		*reinterpret_cast<__v2di *>(dest + n - 16) = *reinterpret_cast<const __v2di *>(src + n - 16);
+	}
+	*reinterpret_cast<__v2di *>(dest + n - 16) = *reinterpret_cast<const __v2di *>(src + n - 16);
+	*reinterpret_cast<__v2di *>(dest) = head;
 }
 
-size_t strnlen(const char *str, size_t maxlen) {
-	size_t len = 0;
-	while (str[len] && len < maxlen) {
-		len++;
+/**
+ * @brief Fill with non-temporal stores, which bypass the cache
+ *
+ * @param dest The destination buffer
+ * @param pattern The byte to fill with, repeated 8 times
+ * @param n The number of bytes to fill, at least 16
+ */
+static void __fill_non_temporal(char *dest, uint64_t pattern, size_t n) {
+	const __v2di value = {static_cast<long long>(pattern), static_cast<long long>(pattern)};
+	*reinterpret_cast<__v2di *>(dest) = value;
+
+	size_t offset = 16 - (reinterpret_cast<uintptr_t>(dest) & 15);
+	for (; offset + 16 <= n; offset += 16) {
+		__builtin_ia32_movntdq(reinterpret_cast<__v2di_aligned *>(dest + offset), value);
 	}
-	return len;
+	__builtin_ia32_sfence();
+
+	*reinterpret_cast<__v2di *>(dest + n - 16) = value;
 }
 
-int strcmp(const char *str1, const char *str2) {
-	while (*str1 && *str2 && *str1 == *str2) {
-		str1++;
-		str2++;
+/**
+ * @brief Fill 16 bytes at a time with SSE2
+ *
+ * @param dest The destination buffer
+ * @param pattern The byte to fill with, repeated 8 times
+ * @param n The number of bytes to fill
+ */
+static void __fill_sse2(char *dest, uint64_t pattern, size_t n) {
+	if (n < 16) {
+		__fill_small(dest, pattern, n);
+		return;
+	}
+	if (n >= NON_TEMPORAL_THRESHOLD) {
+		__fill_non_temporal(dest, pattern, n);
+		return;
+	}
+
+	const __v2di value = {static_cast<long long>(pattern), static_cast<long long>(pattern)};
+	size_t offset = 0;
+	for (; offset + 64 <= n; offset += 64) {
+		__v2di *out = reinterpret_cast<__v2di *>(dest + offset);
+		out[0] = value;
+		out[1] = value;
+		out[2] = value;
+		out[3] = value;
+	}
+	for (; offset + 16 <= n; offset += 16) {
+		*reinterpret_cast<__v2di *>(dest + offset) = value;
 	}
+	*reinterpret_cast<__v2di *>(dest + n - 16) = value;
+}
 
-	return *str1 - *str2;
+/**
+ * @brief Compare 16 aligned bytes against a character
+ *
+ * @param ptr The bytes, aligned to 16 bytes so that the load cannot cross into another page
+ * @param c The character to compare against
+ * @return A mask with bit i set if ptr[i] == c
+ */
+static inline uint32_t __match(const char *ptr, char c) {
+	auto chunk = *reinterpret_cast<const __v16qi_aligned *>(ptr);
+	return __builtin_ia32_pmovmskb128(chunk == c);
 }
 
-int strncmp(const char *str1, const char *str2, size_t n) {
-	while (n > 0 && *str1 && *str2 && *str1 == *str2) {
-		str1++;
-		str2++;
-		n--;
+/**
+ * @brief Check if an unaligned 16 byte load from a pointer stays within its page
+ *
+ * @param ptr The pointer
+ * @return true if the load is safe, false otherwise
+ */
+static inline bool __page_safe(const void *ptr) {
+	return (reinterpret_cast<uintptr_t>(ptr) & (PAGE_BOUNDARY - 1)) <= PAGE_BOUNDARY - 16;
+}
+
+/**
+ * @brief Find the length of a string 16 bytes at a time with SSE2
+ *
+ * @param str The string
+ * @return The length of the string
+ */
+static size_t __strlen_sse2(const char *str) {
+	// loads are aligned so they never cross into an unmapped page, bytes before str are shifted out
+	size_t offset = reinterpret_cast<uintptr_t>(str) & 15;
+	auto ptr = str - offset;
+	uint32_t mask = __match(ptr, '\0') >> offset;
+	if (mask != 0) {
+		return __builtin_ctz(mask);
 	}
 
+	while (true) {
+		ptr += 16;
+		mask = __match(ptr, '\0');
+		if (mask != 0) {
+			return ptr - str + __builtin_ctz(mask);
+		}
+	}
+}
+
+/**
+ * @brief Find a character in at most n bytes, stopping at a terminator if requested
+ *
+ * @param str The bytes to search
+ * @param c The character to find
+ * @param n The maximum number of bytes to search
+ * @param stop_at_nul Whether to also stop at a terminator
+ * @return The index of the first match, or n if there is none
+ */
+static size_t __find_sse2(const char *str, char c, size_t n, bool stop_at_nul) {
 	if (n == 0) {
 		return 0;
 	}
-	return *str1 - *str2;
+
+	size_t offset = reinterpret_cast<uintptr_t>(str) & 15;
+	auto ptr = str - offset;
+	uint32_t mask = (__match(ptr, c) | (stop_at_nul ? __match(ptr, '\0') : 0)) >> offset;
+	size_t index = 0;
+	if (mask != 0) {
+		index = __builtin_ctz(mask);
+		return index < n ? index : n;
+	}
+
+	for (index = 16 - offset; index < n; index += 16) {
+		ptr += 16;
+		mask = __match(ptr, c) | (stop_at_nul ? __match(ptr, '\0') : 0);
+		if (mask != 0) {
+			index += __builtin_ctz(mask);
+			return index < n ? index : n;
+		}
+	}
+	return n;
+}
+
+/**
+ * @brief Find the length of a string 16 bytes at a time with SSE2, up to a maximum
+ *
+ * @param str The string
+ * @param maxlen The maximum length
+ * @return The length of the string, or maxlen if it is longer
+ */
+static size_t __strnlen_sse2(const char *str, size_t maxlen) {
+	return __find_sse2(str, '\0', maxlen, false);
+}
+
+/**
+ * @brief Find a byte in a buffer 16 bytes at a time with SSE2
+ *
+ * @param buf The buffer
+ * @param c The byte to find
+ * @param n The size of the buffer
+ * @return A pointer to the byte, or nullptr if not found
+ */
+static void *__memchr_sse2(const void *buf, int c, size_t n) {
+	auto str = static_cast<const char *>(buf);
+	auto index = __find_sse2(str, static_cast<char>(c), n, false);
+	return index < n ? const_cast<char *>(str + index) : nullptr;
+}
+
+/**
+ * @brief Find a character in a string 16 bytes at a time with SSE2
+ *
+ * @param str The string
+ * @param c The character to find, may be the terminator
+ * @return A pointer to the character, or nullptr if not found
+ */
+static char *__strchr_sse2(const char *str, int c) {
+	auto index = __find_sse2(str, static_cast<char>(c), SIZE_MAX, true);
+	return str[index] == static_cast<char>(c) ? const_cast<char *>(str + index) : nullptr;
+}
+
+/**
+ * @brief Compare two buffers 16 bytes at a time with SSE2
+ *
+ * @param buf1 The first buffer
+ * @param buf2 The second buffer
+ * @param n The number of bytes to compare
+ * @return The difference between the first differing bytes, or 0 if equal
+ */
+static int __memcmp_sse2(const void *buf1, const void *buf2, size_t n) {
+	auto bytes1 = static_cast<const unsigned char *>(buf1);
+	auto bytes2 = static_cast<const unsigned char *>(buf2);
+	if (n < 16) {
+		return __memcmp_bytes(bytes1, bytes2, n);
+	}
+
+	// the last chunk overlaps the previous one, so no load goes past the end of either buffer
+	for (size_t i = 0;; i += 16) {
+		if (i + 16 > n) {
+			i = n - 16;
+		}
+		auto a = *reinterpret_cast<const __v16qi *>(bytes1 + i);
+		auto b = *reinterpret_cast<const __v16qi *>(bytes2 + i);
+		uint32_t mask = __builtin_ia32_pmovmskb128(a == b) ^ 0xFFFF;
+		if (mask != 0) {
+			i += __builtin_ctz(mask);
+			return bytes1[i] - bytes2[i];
+		}
+		if (i + 16 == n) {
+			return 0;
+		}
+	}
+}
+
+/**
+ * @brief Compare two strings 16 bytes at a time with SSE2, up to a maximum length
+ *
+ * @param str1 The first string
+ * @param str2 The second string
+ * @param n The maximum number of characters to compare
+ * @return The difference between the first differing characters, or 0 if equal
+ */
+static int __strncmp_sse2(const char *str1, const char *str2, size_t n) {
+	while (n > 0) {
+		// neither string is aligned, so fall back to a single byte when a load would cross a page boundary
+		if (!__page_safe(str1) || !__page_safe(str2)) {
+			auto c1 = static_cast<unsigned char>(*str1);
+			auto c2 = static_cast<unsigned char>(*str2);
+			if (c1 != c2 || c1 == '\0') {
+				return c1 - c2;
+			}
+			str1++;
+			str2++;
+			n--;
+			continue;
+		}
+
+		auto a = *reinterpret_cast<const __v16qi *>(str1);
+		auto b = *reinterpret_cast<const __v16qi *>(str2);
+		// set for each byte that differs or is the terminator
+		uint32_t mask = __builtin_ia32_pmovmskb128((a == b) & (a != 0)) ^ 0xFFFF;
+		if (n < 16) {
+			mask &= (1U << n) - 1;
+		}
+		if (mask != 0) {
+			auto i = __builtin_ctz(mask);
+			return static_cast<unsigned char>(str1[i]) - static_cast<unsigned char>(str2[i]);
+		}
+		if (n <= 16) {
+			return 0;
+		}
+		str1 += 16;
+		str2 += 16;
+		n -= 16;
+	}
+	return 0;
+}
+
+/**
+ * @brief Compare two strings 16 bytes at a time with SSE2
+ *
+ * @param str1 The first string
+ * @param str2 The second string
+ * @return The difference between the first differing characters, or 0 if equal
+ */
+static int __strcmp_sse2(const char *str1, const char *str2) {
+	return __strncmp_sse2(str1, str2, SIZE_MAX);
+}
+
+#pragma GCC pop_options
+
+// FSRM makes rep movsb fast for short copies too
+static size_t _movsb_threshold = REP_THRESHOLD;
+
+/**
+ * @brief Copy forwards with rep movsb, which is the fastest method on CPUs with ERMS
+ *
+ * @param dest The destination buffer
+ * @param src The source buffer
+ * @param n The number of bytes to copy
+ *
+ * @note Handles overlapping buffers where dest < src
+ */
+static void __copy_movsb(char *dest, const char *src, size_t n) {
+	if (n < _movsb_threshold || n >= NON_TEMPORAL_THRESHOLD) {
+		__copy_sse2(dest, src, n);
+		return;
+	}
+	asm volatile("rep movsb" : "+D"(dest), "+S"(src), "+c"(n) : : "memory");
+}
+
+/**
+ * @brief Fill with rep stosb, which is the fastest method on CPUs with ERMS
+ *
+ * @param dest The destination buffer
+ * @param pattern The byte to fill with, repeated 8 times
+ * @param n The number of bytes to fill
+ */
+static void __fill_stosb(char *dest, uint64_t pattern, size_t n) {
+	if (n < REP_THRESHOLD || n >= NON_TEMPORAL_THRESHOLD) {
+		__fill_sse2(dest, pattern, n);
+		return;
+	}
+	asm volatile("rep stosb" : "+D"(dest), "+c"(n) : "a"(pattern) : "memory");
+}
+
+// the general purpose register versions are used until __string_init() selects the best for the CPU
+static CopyFunc _copy_forward = __copy_movsq;
+static CopyFunc _copy_backward = __copy_backward_u64;
+static FillFunc _fill = __fill_stosq;
+static decltype(&strlen) _strlen = __strlen_bytes;
+static decltype(&strnlen) _strnlen = __strnlen_bytes;
+static decltype(&memchr) _memchr = __memchr_bytes;
+static decltype(&strchr) _strchr = __strchr_bytes;
+static decltype(&memcmp) _memcmp = __memcmp_bytes;
+static decltype(&strcmp) _strcmp = __strcmp_bytes;
+static decltype(&strncmp) _strncmp = __strncmp_bytes;
+
+#ifdef __is_kernel
+/**
+ * @brief Select the fastest memory and string function implementations for the CPU
+ *
+ * @note Must be called after SSE has been enabled
+ */
+extern "C" void __string_init(void) {
+	// x86_64 requires SSE2, which is enabled by the time this is called
+	_copy_forward = __copy_sse2;
+	_copy_backward = __copy_backward_sse2;
+	_fill = __fill_sse2;
+	_strlen = __strlen_sse2;
+	_strnlen = __strnlen_sse2;
+	_memchr = __memchr_sse2;
+	_strchr = __strchr_sse2;
+	_memcmp = __memcmp_sse2;
+	_strcmp = __strcmp_sse2;
+	_strncmp = __strncmp_sse2;
+
+	if (CPU::has_feature(CPU::Feature::ERMS)) {
+		if (CPU::has_feature(CPU::Feature::FSRM)) {
+			_movsb_threshold = 16;
+		}
+		_copy_forward = __copy_movsb;
+		_fill = __fill_stosb;
+	}
+}
+#endif
+
+
+void *memccpy(void *dest, const void *src, int c, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+		static_cast<char *>(dest)[i] = static_cast<const char *>(src)[i];
+		if (static_cast<const char *>(src)[i] == c) {
+			return static_cast<char *>(dest) + i + 1;
+		}
+	}
+
+	return nullptr;
+}
+
+void *memchr(const void *buf, int c, size_t n) {
+	return _memchr(buf, c, n);
+}
+
+int memcmp(const void *buf1, const void *buf2, size_t n) {
+	return _memcmp(buf1, buf2, n);
+}
+
+void *memcpy(void *dest, const void *src, size_t n) {
+	_copy_forward(static_cast<char *>(dest), static_cast<const char *>(src), n);
+	return dest;
+}
+
+void *memmove(void *dest, const void *src, size_t n) {
+	// dest - src wraps around when dest < src, in which case a forward copy is safe
+	if (reinterpret_cast<uintptr_t>(dest) - reinterpret_cast<uintptr_t>(src) >= n) {
+		_copy_forward(static_cast<char *>(dest), static_cast<const char *>(src), n);
+	} else {
+		_copy_backward(static_cast<char *>(dest), static_cast<const char *>(src), n);
+	}
+	return dest;
+}
+
+void *memset(void *buf, int value, size_t n) {
+	_fill(static_cast<char *>(buf), static_cast<uint8_t>(value) * 0x0101010101010101, n);
+	return buf;
+}
+
+size_t strlen(const char *str) {
+	return _strlen(str);
+}
+
+size_t strnlen(const char *str, size_t maxlen) {
+	return _strnlen(str, maxlen);
+}
+
+int strcmp(const char *str1, const char *str2) {
+	return _strcmp(str1, str2);
+}
+
+int strncmp(const char *str1, const char *str2, size_t n) {
+	return _strncmp(str1, str2, n);
 }
 
 char *strtok(char *str, const char *delim) {
@@ -153,14 +799,7 @@ char *strtok_r(char *str, const char *delim, char **saveptr) {
 }
 
 char *strchr(const char *str, int c) {
-	while (*str) {
-		if (*str == c) {
-			return const_cast<char *>(str);
-		}
-		str++;
-	}
-
-	return nullptr;
+	return _strchr(str, c);
 }
 
 char *strrchr(const char *str, int c) {
@@ -15,19 +15,16 @@
 #include <unistd.h>
 
 #ifdef __is_kernel
-#include <kernel/arch/uart.h>
+#include <kernel/arch/console.h>
 #else
 #error "Userland stdio not implemented"
 #endif
 
 ssize_t write(int fd, const void *buf, size_t count) {
 #ifdef __is_kernel
-	if (fd == 1 || fd == 2) {
-		UART uart(UART::COM1);
-		for (size_t i = 0; i < count; i++) {
-			uart.write((reinterpret_cast<const char *>(buf))[i]);
-		}
-		return count;
+	auto written = Console::write(fd, std::span(static_cast<const uint8_t *>(buf), count));
+	if (written >= 0) {
+		return written;
 	}
 	errno = ENOTSUP;
 #else